@@ -0,0 +1,201 @@
+// FILE: columnexam.cpp
+
+// This program calls three test functions to test the column_statistician
+// class: every column must be the same, in every statistic, as a
+// statistician given that column alone with next_batch (or next).
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "columns.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 30, SCORE3 = 30;
+const size_t WIDTHS[ ] = { 1, 3, 7 };
+const size_t BATCHES[ ] = { 1, 0, 1023, 1025, 5000, 2 };   // Rows per batch, in turn
+
+// Are a and b the same in every statistic (bit for bit)?
+bool identical(const statistician& a, const statistician& b)
+{
+    if (a.length( ) != b.length( )) return false;
+    if (a.length( ) == 0) return true;
+    return a.sum( ) == b.sum( ) && a.minimum( ) == b.minimum( )
+        && a.maximum( ) == b.maximum( ) && a.variance( ) == b.variance( )
+        && a.skewness( ) == b.skewness( ) && a.kurtosis( ) == b.kurtosis( );
+}
+
+// Row r of column c: each column has its own shape (rising, falling,
+// constant, cancelling, random).
+double cell(size_t c, size_t r)
+{
+    unsigned long long h = (r + 1) * 6364136223846793005ULL + c * 1442695040888963407ULL;
+    h ^= h >> 29;
+    double u = double(h >> 11) / 9007199254740992.0;
+    switch (c % 5)
+    {
+    case 0: return r * 0.5;
+    case 1: return 1e6 - r * 3.25;
+    case 2: return 42;
+    case 3: return (r % 2) ? 1e15 * u : -1e15 * u;
+    default: return (u - 0.5) * exp(u * 20);
+    }
+}
+
+int test1( )
+{
+    // Batches given as one array per column
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    for (size_t w = 0; w < sizeof(WIDTHS) / sizeof(WIDTHS[0]); ++w)
+    {
+        size_t width = WIDTHS[w];
+        column_statistician table(width);
+        vector<statistician> alone(width);
+        size_t row = 0;
+
+        if (table.width( ) != width || table.length( ) != 0) return 0;
+        for (size_t b = 0; b < sizeof(BATCHES) / sizeof(BATCHES[0]); ++b)
+        {
+            size_t rows = BATCHES[b];
+            vector< vector<double> > data(width, vector<double>(rows + 1));
+            vector<const double*> columns(width);
+            for (size_t c = 0; c < width; ++c)
+            {
+                for (size_t r = 0; r < rows; ++r)
+                    data[c][r] = cell(c, row + r);
+                columns[c] = &data[c][0];
+                alone[c].next_batch(columns[c], rows);
+            }
+            table.next_batch(&columns[0], rows);
+            row += rows;
+
+            if (table.length( ) != (long long)(row)) return 0;
+            for (size_t c = 0; c < width; ++c)
+                if (!identical(table.column(c), alone[c])) return 0;
+        }
+    }
+    return SCORE1;
+}
+
+int test2( )
+{
+    // Batches given as one block with a stride; the numbers between a
+    // column's rows and the next column must be left out.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    for (size_t w = 0; w < sizeof(WIDTHS) / sizeof(WIDTHS[0]); ++w)
+    {
+        size_t width = WIDTHS[w];
+        column_statistician table(width), tight(width);
+        vector<statistician> alone(width);
+        size_t row = 0;
+
+        for (size_t b = 0; b < sizeof(BATCHES) / sizeof(BATCHES[0]); ++b)
+        {
+            size_t rows = BATCHES[b];
+            size_t stride = rows + 5;
+            vector<double> block(width * stride, 1e300);   // Padding
+            vector<double> packed(width * rows + 1);
+            for (size_t c = 0; c < width; ++c)
+            {
+                for (size_t r = 0; r < rows; ++r)
+                {
+                    block[c * stride + r] = cell(c, row + r);
+                    packed[c * rows + r] = cell(c, row + r);
+                }
+                alone[c].next_batch(&block[c * stride], rows);
+            }
+            table.next_batch(&block[0], rows, stride);
+            tight.next_batch(&packed[0], rows, rows);
+            row += rows;
+
+            for (size_t c = 0; c < width; ++c)
+            {
+                if (!identical(table.column(c), alone[c])) return 0;
+                if (!identical(tight.column(c), alone[c])) return 0;
+                if (row > 0 && table.column(c).maximum( ) == 1e300) return 0;
+            }
+        }
+    }
+    return SCORE2;
+}
+
+int test3( )
+{
+    // next_row against next on each column, the + operator against + on
+    // each column, and reset.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    const size_t WIDTH = 5;
+    column_statistician first(WIDTH), second(WIDTH);
+    vector<statistician> alone1(WIDTH), alone2(WIDTH);
+    vector<double> row(WIDTH);
+
+    for (size_t r = 0; r < 3000; ++r)
+    {
+        for (size_t c = 0; c < WIDTH; ++c)
+        {
+            row[c] = cell(c, r);
+            if (r < 1000) alone1[c].next(row[c]);
+            else alone2[c].next(row[c]);
+        }
+        if (r < 1000) first.next_row(&row[0]);
+        else second.next_row(&row[0]);
+    }
+    column_statistician both = first + second;
+    column_statistician swapped = second + first;
+    if (both.length( ) != 3000 || both.width( ) != WIDTH) return 0;
+    for (size_t c = 0; c < WIDTH; ++c)
+    {
+        if (!identical(first.column(c), alone1[c])) return 0;
+        if (!identical(both.column(c), alone1[c] + alone2[c])) return 0;
+        if (!identical(swapped.column(c), alone2[c] + alone1[c])) return 0;
+    }
+
+    // The columns are ordinary statisticians that can be copied.
+    statistician copy = both.column(3);
+    both.reset( );
+    if (both.length( ) != 0 || both.width( ) != WIDTH) return 0;
+    if (copy.length( ) != 3000) return 0;
+    both.next_row(&row[0]);
+    for (size_t c = 0; c < WIDTH; ++c)
+        if (both.column(c).length( ) != 1 || both.column(c).sum( ) != row[c]) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running column_statistician tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing batches of one array per column (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing batches stored as one block (30 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing next_row, the + operator and reset (30 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the column_statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,54 @@
+// FILE: columns.cpp
+// brief Implementation of the column_statistician class.
+
+#include <cassert>   // Provides assert
+#include "columns.h"
+
+namespace CISP430_A1 {
+
+	// Constructor
+	column_statistician::column_statistician(size_type width) : stats(width) {
+		assert(width > 0);
+	}
+
+	// Add a batch given as one array per column
+	void column_statistician::next_batch(const double* const* columns, size_type rows) {
+		for (size_type c = 0; c < stats.size(); ++c)
+			stats[c].next_batch(columns[c], rows);
+	}
+
+	// Add a batch given as one block, one column after another
+	void column_statistician::next_batch(const double* block, size_type rows, size_type stride) {
+		assert(stride >= rows);
+		for (size_type c = 0; c < stats.size(); ++c)
+			stats[c].next_batch(block + c * stride, rows);
+	}
+
+	// Add a single row
+	void column_statistician::next_row(const double* row) {
+		for (size_type c = 0; c < stats.size(); ++c)
+			stats[c].next(row[c]);
+	}
+
+	// Reset every column
+	void column_statistician::reset() {
+		for (size_type c = 0; c < stats.size(); ++c)
+			stats[c].reset();
+	}
+
+	// The statistician of one column
+	const statistician& column_statistician::column(size_type c) const {
+		assert(c < stats.size());
+		return stats[c];
+	}
+
+	// Overload the + operator to combine two tables column by column
+	column_statistician operator+(const column_statistician& s1, const column_statistician& s2) {
+		assert(s1.width() == s2.width());
+		column_statistician result(s1);
+		for (column_statistician::size_type c = 0; c < result.stats.size(); ++c)
+			result.stats[c] = s1.stats[c] + s2.stats[c];
+		return result;
+	}
+
+} // namespace CISP430_A1
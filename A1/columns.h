@@ -0,0 +1,95 @@
+// FILE: columns.h
+// CLASS PROVIDED: column_statistician
+//   (one statistician for each column of a table of numbers that arrives
+//   in column-major batches, such as the record batches of a columnar file)
+//   This class is part of the namespace CISP430_A1.
+//
+//   A batch is given as one array per column (struct of arrays). Each
+//   column's rows are handed to next_batch of that column's statistician,
+//   so the count, sum, minimum and maximum are computed by the vectorized
+//   kernel of stats.cpp while the moments are updated from the same chunk
+//   in the L1 cache. Every column is read once, from start to end, which
+//   is the order the hardware prefetcher handles best.
+//
+// TYPEDEFS for the column_statistician class:
+//   typedef ____ size_type
+//     column_statistician::size_type is the data type of column numbers and
+//     row counts.
+//
+// CONSTRUCTOR for the column_statistician class:
+//   column_statistician(size_type width)
+//     Precondition: width > 0.
+//     Postcondition: There are width empty columns.
+//
+// PUBLIC MODIFICATION member functions for the column_statistician class:
+//   void next_batch(const double* const* columns, size_type rows)
+//     Precondition: columns points to width( ) pointers, each of which
+//     points to at least rows numbers.
+//     Postcondition: For every column c, the numbers columns[c][0] through
+//     columns[c][rows-1] have been given to the statistician of column c.
+//   void next_batch(const double* block, size_type rows, size_type stride)
+//     Precondition: stride >= rows, and block points to width( ) * stride
+//     numbers; column c starts at block + c * stride.
+//     Postcondition: As above, for a batch stored as one block.
+//   void next_row(const double* row)
+//     Precondition: row points to width( ) numbers.
+//     Postcondition: row[c] has been given to the statistician of column c
+//     (for a record that arrives on its own).
+//   void reset( )
+//     Postcondition: Every column has been cleared.
+//
+// PUBLIC CONSTANT member functions for the column_statistician class:
+//   size_type width( ) const
+//     Postcondition: The return value is the number of columns.
+//   long long length( ) const
+//     Postcondition: The return value is how many rows have been given.
+//   const statistician& column(size_type c) const
+//     Precondition: c < width( )
+//     Postcondition: The return value is the statistician of column c. It
+//     is an ordinary statistician, and may be copied, combined with + and
+//     so on.
+//
+// NON-MEMBER functions for the column_statistician class:
+//   column_statistician operator +(const column_statistician& s1,
+//                                  const column_statistician& s2)
+//     Precondition: s1.width( ) == s2.width( )
+//     Postcondition: Each column of the result contains the numbers of that
+//     column in s1 and in s2.
+//
+// VALUE SEMANTICS for the column_statistician class:
+// Assignments and the copy constructor may be used with column_statistician
+// objects.
+
+#ifndef COLUMNS_H
+#define COLUMNS_H
+#include <cstdlib>   // Provides size_t
+#include <vector>    // Provides vector for the columns
+#include "stats.h"
+
+namespace CISP430_A1
+{
+    class column_statistician
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        // CONSTRUCTOR
+        column_statistician(size_type width);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next_batch(const double* const* columns, size_type rows);
+        void next_batch(const double* block, size_type rows, size_type stride);
+        void next_row(const double* row);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        size_type width( ) const { return stats.size( ); }
+        long long length( ) const { return stats[0].length( ); }
+        const statistician& column(size_type c) const;
+        // FRIEND FUNCTIONS
+        friend column_statistician operator +
+            (const column_statistician& s1, const column_statistician& s2);
+    private:
+        std::vector<statistician> stats;   // One statistician per column
+    };
+}
+
+#endif
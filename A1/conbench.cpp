@@ -0,0 +1,78 @@
+// FILE: conbench.cpp
+// A benchmark for the concurrent_statistician class. For 1, 2, 4, ... up to
+// twice the number of hardware threads, each thread calls next a fixed
+// number of times, first on a concurrent_statistician and then on a plain
+// statistician guarded by a mutex. The total throughput of each is written
+// to cout; the concurrent version should grow in proportion to the thread
+// count (up to the number of cores), while the mutex version does not.
+//
+// Usage: conbench [numbers per thread]     (default 10000000)
+
+#include <chrono>      // Provides steady_clock
+#include <cstdlib>     // Provides EXIT_SUCCESS, atol
+#include <iomanip>     // Provides setw, setprecision
+#include <iostream>    // Provides cout
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "concurrent.h"
+using namespace CISP430_A1;
+using namespace std;
+
+typedef chrono::steady_clock bench_clock;
+
+template <class Work>
+double run_threads(unsigned threads, Work work)
+// Postcondition: work(t) has been run on threads t = 0..threads-1 at the
+// same time, and the return value is the elapsed time in seconds.
+{
+    vector<thread> workers;
+    bench_clock::time_point start = bench_clock::now( );
+    for (unsigned t = 0; t < threads; ++t)
+        workers.push_back(thread(work, t));
+    for (unsigned t = 0; t < threads; ++t)
+        workers[t].join( );
+    return chrono::duration<double>(bench_clock::now( ) - start).count( );
+}
+
+int main(int argc, char* argv[ ])
+{
+    long per_thread = (argc > 1) ? atol(argv[1]) : 10000000L;
+    unsigned cores = thread::hardware_concurrency( );
+    if (cores == 0) cores = 1;
+
+    cout << "threads  concurrent M/s   mutex M/s   (" << per_thread
+         << " numbers per thread, " << cores << " hardware threads)" << endl;
+
+    for (unsigned threads = 1; threads <= 2 * cores; threads *= 2)
+    {
+        concurrent_statistician shared;
+        double fast = run_threads(threads, [&](unsigned t) {
+            for (long i = 0; i < per_thread; ++i)
+                shared.next(double(i + t));
+        });
+
+        statistician locked;
+        mutex lock;
+        double slow = run_threads(threads, [&](unsigned t) {
+            for (long i = 0; i < per_thread; ++i)
+            {
+                lock_guard<mutex> guard(lock);
+                locked.next(double(i + t));
+            }
+        });
+
+        if (shared.snapshot( ).length( ) != locked.length( ))
+        {
+            cout << "    the two statisticians do not agree." << endl;
+            return EXIT_FAILURE;
+        }
+
+        double total = double(per_thread) * threads / 1e6;
+        cout << setw(7) << threads
+             << setw(16) << setprecision(4) << total / fast
+             << setw(12) << total / slow << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
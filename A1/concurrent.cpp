@@ -0,0 +1,105 @@
+// FILE: concurrent.cpp
+// brief Implementation of the concurrent_statistician class.
+
+#include <algorithm> // Provides min_element
+#include <thread>    // Provides hardware_concurrency
+#include "concurrent.h"
+
+namespace CISP430_A1 {
+
+	namespace {
+
+		// Thread numbers are handed out smallest-first, and given back when
+		// a thread exits, so a pool of N threads always uses numbers 0..N-1.
+		std::mutex numbers_lock;
+		std::vector<std::size_t> free_numbers;
+		std::size_t next_number = 0;
+
+		struct thread_number {
+			std::size_t value;
+			thread_number() {
+				std::lock_guard<std::mutex> guard(numbers_lock);
+				if (free_numbers.empty()) {
+					value = next_number++;
+				}
+				else {
+					std::vector<std::size_t>::iterator smallest =
+						std::min_element(free_numbers.begin(), free_numbers.end());
+					value = *smallest;
+					free_numbers.erase(smallest);
+				}
+			}
+			~thread_number() {
+				std::lock_guard<std::mutex> guard(numbers_lock);
+				free_numbers.push_back(value);
+			}
+		};
+
+		std::size_t this_thread_number() {
+			thread_local thread_number number;
+			return number.value;
+		}
+
+	} // unnamed namespace
+
+	// Constructor
+	concurrent_statistician::concurrent_statistician(size_type shards)
+		: slots(shards > 0 ? shards :
+			std::max<size_type>(1, std::thread::hardware_concurrency())) {
+		for (size_type i = 0; i < slots.size(); ++i)
+			slots[i].version.store(0, std::memory_order_relaxed);
+	}
+
+	// Add a new number from the calling thread
+	void concurrent_statistician::next(double r) {
+		size_type number = this_thread_number();
+		if (number >= slots.size()) {
+			std::lock_guard<std::mutex> guard(overflow_lock);
+			overflow.next(r);
+			return;
+		}
+
+		// Only this thread writes this shard, so the counter is bumped with
+		// plain stores; the fence keeps the update after the odd value.
+		shard& mine = slots[number];
+		unsigned version = mine.version.load(std::memory_order_relaxed);
+		mine.version.store(version + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		mine.stats.next(r);
+		mine.version.store(version + 2, std::memory_order_release);
+	}
+
+	// Reset every shard
+	void concurrent_statistician::reset() {
+		for (size_type i = 0; i < slots.size(); ++i) {
+			slots[i].stats.reset();
+			slots[i].version.store(0, std::memory_order_relaxed);
+		}
+		std::lock_guard<std::mutex> guard(overflow_lock);
+		overflow.reset();
+	}
+
+	// Merge the shards with + (in shard order)
+	statistician concurrent_statistician::snapshot() const {
+		statistician result;
+		for (size_type i = 0; i < slots.size(); ++i) {
+			const shard& s = slots[i];
+			statistician copy;
+			unsigned before, after;
+			do {
+				before = s.version.load(std::memory_order_acquire);
+				if (before & 1) {
+					std::this_thread::yield();
+					continue;
+				}
+				copy = s.stats;
+				std::atomic_thread_fence(std::memory_order_acquire);
+				after = s.version.load(std::memory_order_relaxed);
+			} while ((before & 1) || before != after);
+			result = result + copy;
+		}
+		std::lock_guard<std::mutex> guard(overflow_lock);
+		return result + overflow;
+	}
+
+} // namespace CISP430_A1
@@ -0,0 +1,85 @@
+// FILE: concurrent.h
+// CLASS PROVIDED: concurrent_statistician
+//   (a statistician that many threads may feed at the same time)
+//   This class is part of the namespace CISP430_A1.
+//
+//   Each thread that calls next is given its own thread number (numbers of
+//   threads that have exited are reused). The thread with number i updates
+//   shard i, a statistician on its own cache line, so threads never share
+//   a lock or a cache line. Each shard carries a sequence counter that is
+//   bumped before and after every update (plain stores, no atomic
+//   read-modify-write), so that snapshot can copy a shard consistently
+//   while its owner keeps running. Threads numbered beyond the shard count
+//   share one overflow statistician behind a mutex.
+//
+// TYPEDEFS for the concurrent_statistician class:
+//   typedef ____ size_type
+//     concurrent_statistician::size_type is the data type of shard counts.
+//
+// CONSTRUCTOR for the concurrent_statistician class:
+//   concurrent_statistician(size_type shards = 0)
+//     Postcondition: The statistician is empty and has the given number of
+//     lock-free shards (0 means one per hardware thread).
+//
+// PUBLIC MODIFICATION member functions for the concurrent_statistician class:
+//   void next(double r)
+//     Postcondition: The number r has been given to the statistician. Any
+//     number of threads may call next at the same time.
+//   void reset( )
+//     Precondition: No other thread is calling next.
+//     Postcondition: The statistician has been cleared.
+//
+// PUBLIC CONSTANT member functions for the concurrent_statistician class:
+//   statistician snapshot( ) const
+//     Postcondition: The return value is the + of all the shards, that is, a
+//     statistician holding every number given so far (numbers given while
+//     snapshot runs may or may not be included). It may be called while
+//     other threads are calling next.
+//   size_type shards( ) const
+//     Postcondition: The return value is the number of lock-free shards.
+//
+// VALUE SEMANTICS for the concurrent_statistician class:
+// concurrent_statistician objects may not be copied or assigned.
+//
+// Programs that use this class must be linked with the thread library
+// (-pthread). conbench.cpp measures how next scales with the thread count.
+
+#ifndef CONCURRENT_H
+#define CONCURRENT_H
+#include <atomic>    // Provides atomic for the shard sequence counters
+#include <cstdlib>   // Provides size_t
+#include <mutex>     // Provides mutex for the overflow shard
+#include <vector>
+#include "stats.h"
+
+namespace CISP430_A1
+{
+    class concurrent_statistician
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        // CONSTRUCTOR
+        concurrent_statistician(size_type shards = 0);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(double r);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        statistician snapshot( ) const;
+        size_type shards( ) const { return slots.size( ); }
+    private:
+        struct alignas(64) shard
+        {
+            std::atomic<unsigned> version;  // Odd while the owner is updating
+            statistician stats;             // The owner's numbers
+        };
+        std::vector<shard> slots;      // One shard per thread number
+        mutable std::mutex overflow_lock;
+        statistician overflow;         // Numbers from threads beyond the shards
+        // Not copyable
+        concurrent_statistician(const concurrent_statistician&);
+        void operator =(const concurrent_statistician&);
+    };
+}
+
+#endif
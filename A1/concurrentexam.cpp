@@ -0,0 +1,186 @@
+// FILE: concurrentexam.cpp
+
+// This program calls three test functions to test the concurrent_statistician
+// class with several producer threads, comparing what it holds with a plain
+// statistician given the same numbers one at a time.
+// Maximum number of points from this program is 100.
+// (Link with -pthread.)
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "concurrent.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 30, SCORE3 = 30;
+const int PER_THREAD = 200000;
+
+bool close(double a, double b)
+{
+    const double EPSILON = 1e-9;
+    return (fabs(a-b) <= EPSILON * (1 + fabs(b)));
+}
+
+// The i-th number producer t gives. They are whole numbers, so every sum
+// is exact whatever order the shards are merged in.
+double number(int t, int i)
+{
+    return double((t * 7919 + i * 31) % 20011) - 10005 + ((i == t) ? 1e6 * (t + 1) : 0);
+}
+
+// Run producers threads at once; thread t gives number(t, 0..count-1) to c.
+void produce(concurrent_statistician& c, int producers, int count)
+{
+    vector<thread> workers;
+    for (int t = 0; t < producers; ++t)
+        workers.push_back(thread([&c, t, count]( ) {
+            for (int i = 0; i < count; ++i)
+                c.next(number(t, i));
+        }));
+    for (int t = 0; t < producers; ++t)
+        workers[t].join( );
+}
+
+// Does the merged statistician hold what a serial one given the numbers
+// of producers threads holds? Length, sum, minimum and maximum must be
+// equal exactly.
+bool same_as_serial(const statistician& merged, int producers, int count)
+{
+    statistician serial;
+    for (int t = 0; t < producers; ++t)
+        for (int i = 0; i < count; ++i)
+            serial.next(number(t, i));
+
+    if (merged.length( ) != serial.length( )) return false;
+    if (merged.sum( ) != serial.sum( )) return false;
+    if (merged.minimum( ) != serial.minimum( )) return false;
+    if (merged.maximum( ) != serial.maximum( )) return false;
+    if (!close(merged.mean( ), serial.mean( ))) return false;
+    return close(merged.variance( ), serial.variance( ));
+}
+
+int test1( )
+{
+    // Producers on shards of their own, and more producers than shards so
+    // that some share the overflow statistician.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    const int PRODUCERS[ ] = { 1, 2, 4, 8 };
+    const concurrent_statistician::size_type SHARDS[ ] = { 1, 3, 8 };
+
+    for (size_t p = 0; p < sizeof(PRODUCERS) / sizeof(PRODUCERS[0]); ++p)
+    {
+        for (size_t s = 0; s < sizeof(SHARDS) / sizeof(SHARDS[0]); ++s)
+        {
+            concurrent_statistician c(SHARDS[s]);
+            if (c.shards( ) != SHARDS[s]) return 0;
+            produce(c, PRODUCERS[p], PER_THREAD);
+            if (!same_as_serial(c.snapshot( ), PRODUCERS[p], PER_THREAD)) return 0;
+        }
+    }
+
+    concurrent_statistician automatic;
+    if (automatic.shards( ) < 1) return 0;
+    produce(automatic, 3, PER_THREAD);
+    if (!same_as_serial(automatic.snapshot( ), 3, PER_THREAD)) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // Snapshots taken while producers run: each is a consistent copy (the
+    // producers only give 1s, so the sum equals the length), the length
+    // never goes down, and the last one holds everything.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    const int PRODUCERS = 4;
+    concurrent_statistician c(2);
+    vector<thread> workers;
+    bool okay = true;
+
+    for (int t = 0; t < PRODUCERS; ++t)
+        workers.push_back(thread([&c]( ) {
+            for (int i = 0; i < PER_THREAD; ++i)
+                c.next(1);
+        }));
+
+    long long seen = 0;
+    for (int k = 0; k < 2000 && okay; ++k)
+    {
+        statistician s = c.snapshot( );
+        if (s.length( ) < seen) okay = false;
+        if (s.sum( ) != double(s.length( ))) okay = false;
+        if (s.length( ) > 0 && (s.minimum( ) != 1 || s.maximum( ) != 1)) okay = false;
+        seen = s.length( );
+    }
+    for (int t = 0; t < PRODUCERS; ++t)
+        workers[t].join( );
+
+    if (!okay) return 0;
+    statistician last = c.snapshot( );
+    if (last.length( ) != (long long)(PRODUCERS) * PER_THREAD) return 0;
+    if (last.sum( ) != double(PRODUCERS) * PER_THREAD) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // reset clears every shard and the overflow, and a second pool of
+    // threads (reusing the thread numbers of the first) starts over.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    concurrent_statistician c(2);
+    produce(c, 5, 1000);
+    if (!same_as_serial(c.snapshot( ), 5, 1000)) return 0;
+
+    c.reset( );
+    if (c.snapshot( ).length( ) != 0) return 0;
+    produce(c, 6, PER_THREAD);
+    if (!same_as_serial(c.snapshot( ), 6, PER_THREAD)) return 0;
+
+    // The main thread is a producer too.
+    c.reset( );
+    c.next(-4);
+    c.next(10);
+    statistician mine = c.snapshot( );
+    if (mine.length( ) != 2 || mine.sum( ) != 6) return 0;
+    if (mine.minimum( ) != -4 || mine.maximum( ) != 10) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running concurrent_statistician tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing several producers against a serial statistician (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing snapshots taken while producers run (30 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing reset and a second pool of producers (30 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the concurrent_statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,95 @@
+// FILE: decayed.cpp
+// brief Implementation of the decayed_statistician class.
+
+#include <cassert>   // Provides assert
+#include <cmath>     // Provides exp2, sqrt
+#include "decayed.h"
+
+namespace CISP430_A1 {
+
+	// Constructor
+	decayed_statistician::decayed_statistician(double half_life)
+		: half(half_life), clock(0.0), count(0), total_weight(0.0), center(0.0), m2(0.0) {
+		assert(half_life > 0);
+	}
+
+	// How much a weight shrinks over elapsed time
+	double decayed_statistician::factor(double elapsed) const {
+		return std::exp2(-elapsed / half);
+	}
+
+	// Move the clock on, decaying the weight and the squared distances
+	void decayed_statistician::advance(double now) {
+		if (now <= clock) return;
+		double f = factor(now - clock);
+		total_weight *= f;
+		m2 *= f;
+		clock = now;
+	}
+
+	// Add a number (West's weighted form of Welford's update)
+	void decayed_statistician::next(double r, double now) {
+		advance(now);
+		double w = (now < clock) ? factor(clock - now) : 1.0;
+		++count;
+		total_weight += w;
+		double delta = r - center;
+		center += delta * w / total_weight;
+		m2 += w * delta * (r - center);
+	}
+
+	// Reset the statistician
+	void decayed_statistician::reset() {
+		clock = 0.0;
+		count = 0;
+		total_weight = 0.0;
+		center = 0.0;
+		m2 = 0.0;
+	}
+
+	double decayed_statistician::mean() const {
+		assert(total_weight > 0);
+		return center;
+	}
+
+	double decayed_statistician::variance() const {
+		assert(total_weight > 0);
+		return m2 / total_weight;
+	}
+
+	double decayed_statistician::stddev() const {
+		return std::sqrt(variance());
+	}
+
+	// Overload the + operator: decay both to the later clock, then combine
+	// the weighted means and squared distances
+	decayed_statistician operator+(const decayed_statistician& s1, const decayed_statistician& s2) {
+		assert(s1.half == s2.half);
+		if (s2.count == 0) {
+			decayed_statistician result(s1);
+			result.advance(s2.clock);
+			return result;
+		}
+		if (s1.count == 0) {
+			decayed_statistician result(s2);
+			result.advance(s1.clock);
+			return result;
+		}
+
+		decayed_statistician a(s1), b(s2);
+		double latest = (a.clock > b.clock) ? a.clock : b.clock;
+		a.advance(latest);
+		b.advance(latest);
+
+		decayed_statistician result(a);
+		result.count = a.count + b.count;
+		result.total_weight = a.total_weight + b.total_weight;
+		if (result.total_weight > 0) {
+			double d = b.center - a.center;
+			result.center = a.center + d * b.total_weight / result.total_weight;
+			result.m2 = a.m2 + b.m2 + d * d * a.total_weight * b.total_weight / result.total_weight;
+		}
+		return result;
+	}
+
+} // namespace CISP430_A1
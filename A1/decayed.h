@@ -0,0 +1,101 @@
+// FILE: decayed.h
+// CLASS PROVIDED: decayed_statistician
+//   (a statistician whose mean and variance weight each number by its age,
+//   so that recent numbers count the most)
+//   This class is part of the namespace CISP430_A1.
+//
+//   A number given at time t has weight 2^(-(now - t) / half_life) at time
+//   now: it counts half as much after one half-life, a quarter after two,
+//   and so on. Instead of storing the numbers, the class keeps the total
+//   weight, the weighted mean and the weighted sum of squared distances
+//   from the mean, all as of the latest time stamp. When the clock moves
+//   on, the weight and the squared distances are multiplied by the decay
+//   factor (the mean does not change), so every operation is O(1) and
+//   nothing is allocated.
+//
+// CONSTRUCTOR for the decayed_statistician class:
+//   decayed_statistician(double half_life)
+//     Precondition: half_life > 0 (in the same units as the time stamps).
+//     Postcondition: The statistician is empty.
+//
+// PUBLIC MODIFICATION member functions for the decayed_statistician class:
+//   void next(double r, double now)
+//     Postcondition: The number r, stamped with time now, has been given to
+//     the statistician. If now is later than every earlier time stamp, the
+//     clock has been moved to now first; a late number (now earlier than
+//     the clock) is given the weight it has at the current clock time.
+//   void advance(double now)
+//     Postcondition: If now is later than the clock, the clock has been
+//     moved to now, and the weights have decayed accordingly.
+//   void reset( )
+//     Postcondition: The statistician has been cleared.
+//
+// PUBLIC CONSTANT member functions for the decayed_statistician class:
+//   long long length( ) const
+//     Postcondition: The return value is how many numbers have been given.
+//   double half_life( ) const
+//   double now( ) const
+//     Postcondition: The return value is the half-life, or the latest time
+//     stamp given to next or advance (0 if none).
+//   double weight( ) const
+//     Postcondition: The return value is the total weight of the numbers as
+//     of now( ) (about half_life / ln 2 times the rate of arrival for a
+//     steady stream).
+//   double mean( ) const
+//   double variance( ) const
+//   double stddev( ) const
+//     Precondition: weight( ) > 0
+//     Postcondition: The return value is the weighted mean, the weighted
+//     population variance, or its square root.
+//
+// NON-MEMBER functions for the decayed_statistician class:
+//   decayed_statistician operator +(const decayed_statistician& s1,
+//                                   const decayed_statistician& s2)
+//     Precondition: s1 and s2 have the same half-life.
+//     Postcondition: The statistician that is returned holds the numbers of
+//     both, as of the later of their two clocks: the one that is behind is
+//     decayed to that time before the two are combined, so the result is
+//     the same as if one statistician had been given all the numbers.
+//
+// VALUE SEMANTICS for the decayed_statistician class:
+// Assignments and the copy constructor may be used with decayed_statistician
+// objects.
+
+#ifndef DECAYED_H
+#define DECAYED_H
+
+namespace CISP430_A1
+{
+    class decayed_statistician
+    {
+    public:
+        // CONSTRUCTOR
+        decayed_statistician(double half_life);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(double r, double now);
+        void advance(double now);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        long long length( ) const { return count; }
+        double half_life( ) const { return half; }
+        double now( ) const { return clock; }
+        double weight( ) const { return total_weight; }
+        double mean( ) const;
+        double variance( ) const;
+        double stddev( ) const;
+        // FRIEND FUNCTIONS
+        friend decayed_statistician operator +
+            (const decayed_statistician& s1, const decayed_statistician& s2);
+    private:
+        double half;          // The half-life
+        double clock;         // The latest time stamp
+        long long count;      // How many numbers
+        double total_weight;  // Sum of the weights as of clock
+        double center;        // Weighted mean
+        double m2;            // Weighted sum of squared distances from center
+        // HELPER MEMBER FUNCTION
+        double factor(double elapsed) const;
+    };
+}
+
+#endif
@@ -0,0 +1,164 @@
+// FILE: decayexam.cpp
+
+// This program calls three test functions to test the decayed_statistician
+// class against weights worked out for every number separately.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "decayed.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 40, SCORE3 = 20;
+
+struct timed
+{
+    double when;
+    double value;
+};
+
+bool close(double a, double b)
+{
+    const double EPSILON = 1e-9;
+    return (fabs(a-b) < EPSILON * (1 + fabs(a)));
+}
+
+// Does s have the weight, mean and variance of the numbers given, each
+// weighted by 2^(-(now - when) / half_life)?
+bool matches(const decayed_statistician& s, const vector<timed>& given, double half_life, double now)
+{
+    double weight = 0, total = 0, squares = 0;
+    size_t i;
+    for (i = 0; i < given.size( ); ++i)
+    {
+        double w = exp2(-(now - given[i].when) / half_life);
+        weight += w;
+        total += w * given[i].value;
+    }
+    if (s.length( ) != (long long)(given.size( ))) return false;
+    if (!close(s.weight( ), weight)) return false;
+    if (weight == 0) return true;
+    double mean = total / weight;
+    for (i = 0; i < given.size( ); ++i)
+    {
+        double d = given[i].value - mean;
+        squares += exp2(-(now - given[i].when) / half_life) * d * d;
+    }
+    return close(s.mean( ), mean) && close(s.variance( ), squares / weight);
+}
+
+int test1( )
+{
+    // Numbers at irregular times, some of them late, checked against the
+    // weights of every number worked out separately.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    const double HALF = 30;
+    decayed_statistician s(HALF);
+    vector<timed> given;
+    double clock = 0;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        double when = i * 0.37 + ((i % 7 == 3) ? -5.0 : 0.0);   // Every 7th is late
+        if (when < 0) when = 0;
+        timed g = { when, double((i * 53) % 211) - 100 };
+        s.next(g.value, g.when);
+        given.push_back(g);
+        if (when > clock) clock = when;
+        if (s.now( ) != clock) return 0;
+        if (i % 97 == 0 && !matches(s, given, HALF, clock)) return 0;
+    }
+    if (!matches(s, given, HALF, clock)) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // + must give the statistician of all the numbers, decayed to the later
+    // of the two clocks.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    const double HALF = 12.5;
+    decayed_statistician s1(HALF), s2(HALF), both(HALF), empty(HALF);
+    vector<timed> given;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        timed g = { i * 0.1, sin(double(i)) * 50 };
+        if (i % 3 == 0 || i > 900) s1.next(g.value, g.when);
+        else s2.next(g.value, g.when);
+        both.next(g.value, g.when);
+        given.push_back(g);
+    }
+    // s1 saw the last number, so its clock is the later one.
+    if (!matches(s1 + s2, given, HALF, s1.now( ))) return 0;
+    if (!matches(s2 + s1, given, HALF, s1.now( ))) return 0;
+    if (!close((s1 + s2).mean( ), both.mean( ))) return 0;
+    if (!close((s1 + s2).variance( ), both.variance( ))) return 0;
+
+    // An empty statistician with a later clock moves the clock on.
+    empty.advance(200);
+    if (!matches(both + empty, given, HALF, 200)) return 0;
+    if (!matches(empty + both, given, HALF, 200)) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // advance: the weight halves every half-life and the mean stays put;
+    // an earlier time does not move the clock back.
+    // Returns 20 if everything goes okay; otherwise returns 0.
+
+    decayed_statistician s(10);
+
+    s.next(4, 0);
+    s.next(8, 0);
+    if (!close(s.weight( ), 2) || !close(s.mean( ), 6) || !close(s.variance( ), 4)) return 0;
+    s.advance(10);
+    if (!close(s.weight( ), 1) || !close(s.mean( ), 6) || !close(s.variance( ), 4)) return 0;
+    s.advance(5);
+    if (s.now( ) != 10 || !close(s.weight( ), 1)) return 0;
+    s.advance(30);
+    if (!close(s.weight( ), 0.25)) return 0;
+    s.reset( );
+    if (s.length( ) != 0 || s.weight( ) != 0 || s.now( ) != 0) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running decayed_statistician tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing next against separately weighted numbers (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing the + operator (40 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing advance and reset (20 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the decayed_statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
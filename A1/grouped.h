@@ -0,0 +1,132 @@
+// FILE: grouped.h
+// TEMPLATE CLASS PROVIDED: grouped_statistician<Key, Hash>
+//   (a table of statistics, one set per key, for millions of keys)
+//   This class is part of the namespace CISP430_A1.
+//
+//   Each key gets a row number when it is first seen. The count, sum,
+//   minimum and maximum of all the rows are kept in separate arrays
+//   (columns), and the rows are found through an open-addressing index of
+//   32-bit row numbers (linear probing, at most 7/8 full). For 8-byte keys
+//   a row costs 36 bytes of columns plus 4.6 to 9 bytes of index, instead
+//   of a std::map node holding a whole statistician.
+//
+// TEMPLATE PARAMETERS:
+//   Key is the type of the keys. It may be any type with a copy constructor,
+//   an assignment operator and ==. Hash is a function object that maps a
+//   key to a size_t; the default is std::hash<Key>. The hash is mixed again
+//   before it is used, so an identity hash (as std::hash gives for integers)
+//   is fine.
+//
+// TYPEDEFS for the grouped_statistician class:
+//   typedef ____ size_type
+//     grouped_statistician::size_type is the data type of row numbers and
+//     key counts.
+//
+// CONSTRUCTOR for the grouped_statistician class:
+//   grouped_statistician(size_type expected = 0)
+//     Postcondition: The table is empty, with room for expected keys before
+//     it has to grow.
+//
+// PUBLIC MODIFICATION member functions for the grouped_statistician class:
+//   void next(const Key& key, double r)
+//     Postcondition: The number r has been given to the statistics of key
+//     (which are created if this is the first number for key).
+//   void next(const Key* keys, const double* values, size_type n)
+//     Precondition: keys and values each point to n items.
+//     Postcondition: As if next(keys[i], values[i]) had been activated for
+//     i = 0 to n-1. The index lookups for a block of items are started
+//     (with prefetches) before any of the columns are updated, so that
+//     cache misses overlap.
+//   void reset( )
+//     Postcondition: The table has been cleared.
+//
+// PUBLIC CONSTANT member functions for the grouped_statistician class:
+//   size_type size( ) const
+//     Postcondition: The return value is how many keys are in the table.
+//   bool find(const Key& key, size_type& row) const
+//     Postcondition: If key is in the table, row has been set to its row
+//     number and the return value is true; otherwise the return value is
+//     false.
+//   const Key& key_at(size_type row) const
+//   long long length_at(size_type row) const
+//   double sum_at(size_type row) const
+//   double mean_at(size_type row) const
+//   double minimum_at(size_type row) const
+//   double maximum_at(size_type row) const
+//     Precondition: row < size( )
+//     Postcondition: The return value is the key of the row, or the length,
+//     sum, mean, minimum or maximum of the numbers given for that key (the
+//     same values a statistician would report). Rows are numbered from 0 in
+//     the order their keys were first seen, so these functions can be used
+//     to visit the whole table.
+//
+// NON-MEMBER functions for the grouped_statistician class:
+//   grouped_statistician operator +(const grouped_statistician& g1,
+//                                   const grouped_statistician& g2)
+//     Postcondition: The table that is returned has every key of g1 and g2,
+//     and for each key, the statistics of all its numbers in g1 and g2. The
+//     keys of g1 keep their row numbers.
+//
+// VALUE SEMANTICS for the grouped_statistician class:
+// Assignments and the copy constructor may be used with grouped_statistician
+// objects.
+
+#ifndef GROUPED_H
+#define GROUPED_H
+#include <cstdlib>      // Provides size_t
+#include <functional>   // Provides hash
+#include <vector>       // Provides vector for the columns and the index
+
+namespace CISP430_A1
+{
+    template <class Key, class Hash = std::hash<Key> >
+    class grouped_statistician
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        // CONSTRUCTOR
+        grouped_statistician(size_type expected = 0);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(const Key& key, double r);
+        void next(const Key* keys, const double* values, size_type n);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        size_type size( ) const { return keys.size( ); }
+        bool find(const Key& key, size_type& row) const;
+        const Key& key_at(size_type row) const;
+        long long length_at(size_type row) const;
+        double sum_at(size_type row) const;
+        double mean_at(size_type row) const;
+        double minimum_at(size_type row) const;
+        double maximum_at(size_type row) const;
+        // FRIEND FUNCTIONS
+        template <class K, class H>
+        friend grouped_statistician<K, H> operator +
+            (const grouped_statistician<K, H>& g1, const grouped_statistician<K, H>& g2);
+    private:
+        // Columns, one entry per row
+        std::vector<Key> keys;
+        std::vector<unsigned int> counts;
+        std::vector<double> totals;
+        std::vector<double> lows;
+        std::vector<double> highs;
+        // Index: each slot holds row + 1, or 0 if the slot is empty
+        std::vector<unsigned int> index;
+        unsigned int shift;      // 64 - log2(index.size( ))
+        Hash hasher;
+        // HELPER MEMBER FUNCTIONS
+        size_type home_slot(const Key& key) const;
+        size_type row_for(const Key& key, size_type slot);
+        void add(size_type row, double r);
+        void rebuild(size_type slots);
+    };
+
+    template <class Key, class Hash>
+    grouped_statistician<Key, Hash> operator +
+        (const grouped_statistician<Key, Hash>& g1, const grouped_statistician<Key, Hash>& g2);
+}
+
+// The implementation of a template class must be included in its header file:
+#include "grouped.template"
+#endif
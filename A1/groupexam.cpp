@@ -0,0 +1,172 @@
+// FILE: groupexam.cpp
+
+// This program calls three test functions to test the grouped_statistician
+// template class against a std::map of statisticians.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <map>
+#include <vector>
+#include "stats.h"
+#include "grouped.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 30, SCORE3 = 30;
+
+bool close(double a, double b)
+{
+    const double EPSILON = 1e-6;
+    return (fabs(a-b) < EPSILON * (1 + fabs(a)));
+}
+
+// Does the table hold exactly the keys of expected, with the same statistics?
+bool matches(const grouped_statistician<long long>& g, const map<long long, statistician>& expected)
+{
+    size_t row;
+    if (g.size( ) != expected.size( )) return false;
+    for (map<long long, statistician>::const_iterator it = expected.begin( ); it != expected.end( ); ++it)
+    {
+        if (!g.find(it->first, row)) return false;
+        if (g.key_at(row) != it->first) return false;
+        if (g.length_at(row) != it->second.length( )) return false;
+        if (!close(g.sum_at(row), it->second.sum( ))) return false;
+        if (g.minimum_at(row) != it->second.minimum( )) return false;
+        if (g.maximum_at(row) != it->second.maximum( )) return false;
+    }
+    return !g.find(-1, row);
+}
+
+int test1( )
+{
+    // One batch of new keys large enough to make the index grow several
+    // times, then the same keys again one at a time.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    grouped_statistician<long long> g;
+    map<long long, statistician> expected;
+    vector<long long> keys;
+    vector<double> values;
+
+    for (long long i = 0; i < 64; ++i)
+    {
+        keys.push_back(i * 1000003);
+        values.push_back(double(i));
+    }
+    g.next(&keys[0], &values[0], keys.size( ));
+    for (size_t i = 0; i < keys.size( ); ++i)
+        expected[keys[i]].next(values[i]);
+    if (!matches(g, expected)) return 0;
+
+    for (size_t i = 0; i < keys.size( ); ++i)
+    {
+        g.next(keys[i], -values[i]);
+        expected[keys[i]].next(-values[i]);
+    }
+    if (!matches(g, expected)) return 0;
+
+    // A block of mostly new keys in a table that is already large
+    keys.clear( );
+    values.clear( );
+    for (long long i = 0; i < 5000; ++i)
+    {
+        keys.push_back((i * 7919) % 3000);
+        values.push_back(double(i % 101) - 50);
+    }
+    g.next(&keys[0], &values[0], keys.size( ));
+    for (size_t i = 0; i < keys.size( ); ++i)
+        expected[keys[i]].next(values[i]);
+    if (!matches(g, expected)) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // The batched and the single next must build the same table.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    grouped_statistician<long long> one, many(10);
+    map<long long, statistician> expected;
+    vector<long long> keys;
+    vector<double> values;
+    unsigned long long state = 12345;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        keys.push_back((long long)(state >> 50));
+        values.push_back(double(state >> 40 & 1023));
+    }
+    for (size_t i = 0; i < keys.size( ); ++i)
+    {
+        one.next(keys[i], values[i]);
+        expected[keys[i]].next(values[i]);
+    }
+    for (size_t start = 0; start < keys.size( ); start += 777)
+    {
+        size_t n = (keys.size( ) - start < 777) ? keys.size( ) - start : 777;
+        many.next(&keys[start], &values[start], n);
+    }
+    if (!matches(one, expected)) return 0;
+    if (!matches(many, expected)) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // The + operator must give the table of all the numbers of both.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    grouped_statistician<long long> g1, g2, empty;
+    map<long long, statistician> expected;
+
+    for (long long i = 0; i < 3000; ++i)
+    {
+        long long key = i % 1200;
+        double value = double((i * 37) % 501);
+        if (i % 3 == 0) g1.next(key, value);
+        else g2.next(key + 600, value);
+        expected[(i % 3 == 0) ? key : key + 600].next(value);
+    }
+    if (!matches(g1 + g2, expected)) return 0;
+    if (!matches(g2 + g1, expected)) return 0;
+    if (!matches((g1 + empty) + g2, expected)) return 0;
+    if ((empty + empty).size( ) != 0) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running grouped_statistician tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing a batch that makes the index grow several times (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing the batched next against the single next (30 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing the + operator (30 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the grouped_statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
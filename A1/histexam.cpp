@@ -0,0 +1,209 @@
+// FILE: histexam.cpp
+
+// This program calls three test functions to test the log_histogram class:
+// percentiles against the exact order statistics of the values counted
+// (within the documented one part in 10^digits), merged histograms against
+// one histogram of all the values, and values outside the range.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "histogram.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 50, SCORE2 = 30, SCORE3 = 20;
+typedef log_histogram::value_type value_type;
+
+// n values spread evenly over the logarithm of 1..highest (with some
+// zeros and repeats), as latencies are
+vector<value_type> spread(size_t n, value_type highest, unsigned long long seed)
+{
+    vector<value_type> values;
+    unsigned long long state = seed;
+    for (size_t i = 0; i < n; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double u = double(state >> 11) / 9007199254740992.0;
+        if (i % 97 == 0) values.push_back(0);
+        else if (i % 89 == 0 && i > 0) values.push_back(values[i - 1]);
+        else values.push_back(value_type(exp(u * log(double(highest)))));
+    }
+    return values;
+}
+
+// Is reported a fair report of exact: no less, and no more than one part in
+// 10^digits above it (or within the finest bucket, for values below lowest)?
+bool within(value_type reported, value_type exact, value_type lowest, int digits)
+{
+    value_type unit = 1;
+    while (unit * 2 <= lowest) unit *= 2;
+    if (reported < exact) return false;
+    double allowed = max(double(exact) * pow(10.0, -digits), double(unit - 1));
+    return double(reported - exact) <= allowed;
+}
+
+// Do h1 and h2 count the same values?
+bool same_histogram(const log_histogram& h1, const log_histogram& h2)
+{
+    if (h1.length( ) != h2.length( ) || h1.buckets( ) != h2.buckets( )) return false;
+    for (log_histogram::size_type i = 0; i < h1.buckets( ); ++i)
+        if (h1.count_at(i) != h2.count_at(i)) return false;
+    if (h1.length( ) == 0) return true;
+    if (h1.minimum( ) != h2.minimum( ) || h1.maximum( ) != h2.maximum( )) return false;
+    if (h1.mean( ) != h2.mean( )) return false;
+    for (double q = 0; q <= 1; q += 0.125)
+        if (h1.percentile(q) != h2.percentile(q)) return false;
+    return true;
+}
+
+int test1( )
+{
+    // For each precision and two lowest values, the percentiles of spread
+    // out values must be within one part in 10^digits of the exact ones,
+    // the sub-buckets must tile the range, and each must be narrow enough.
+    // Returns 50 if everything goes okay; otherwise returns 0.
+
+    const double QS[ ] = { 0, 0.001, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 0.9999, 1 };
+    const value_type LOWEST[ ] = { 1, 1000 };
+    const value_type HIGHEST = 3600000000ULL;
+
+    for (int digits = 1; digits <= 4; ++digits)
+    {
+        for (size_t k = 0; k < 2; ++k)
+        {
+            log_histogram h(LOWEST[k], HIGHEST, digits);
+            vector<value_type> values = spread(100000, HIGHEST, digits * 10 + k);
+            for (size_t i = 0; i < values.size( ); ++i)
+                h.next(values[i]);
+            sort(values.begin( ), values.end( ));
+
+            if (h.length( ) != values.size( )) return 0;
+            if (h.minimum( ) != values.front( ) || h.maximum( ) != values.back( )) return 0;
+            for (size_t j = 0; j < sizeof(QS) / sizeof(QS[0]); ++j)
+            {
+                size_t rank = size_t(ceil(QS[j] * values.size( )));
+                value_type exact = values[(rank == 0) ? 0 : rank - 1];
+                if (!within(h.percentile(QS[j]), exact, LOWEST[k], digits)) return 0;
+            }
+            if (h.percentile(0) != values.front( ) || h.percentile(1) != values.back( )) return 0;
+
+            // The sub-buckets are contiguous from 0, each holds values within
+            // one part in 10^digits of its lowest, and the counts add up.
+            log_histogram::size_type counted = 0;
+            if (h.lowest_at(0) != 0) return 0;
+            for (log_histogram::size_type i = 0; i < h.buckets( ); ++i)
+            {
+                if (i + 1 < h.buckets( ) && h.highest_at(i) + 1 != h.lowest_at(i + 1)) return 0;
+                if (!within(h.highest_at(i), h.lowest_at(i), LOWEST[k], digits)) return 0;
+                counted += h.count_at(i);
+            }
+            if (counted != h.length( ) || h.highest_at(h.buckets( ) - 1) < HIGHEST) return 0;
+
+            // The mean, with each value taken as the middle of its sub-bucket
+            double total = 0;
+            for (size_t i = 0; i < values.size( ); ++i)
+                total += double(values[i]);
+            double exact_mean = total / values.size( );
+            if (fabs(h.mean( ) - exact_mean) > exact_mean * pow(10.0, -digits) + LOWEST[k]) return 0;
+        }
+    }
+    return SCORE1;
+}
+
+int test2( )
+{
+    // The + of histograms of parts of the values must equal one histogram
+    // of all of them, in either order and with empty histograms.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    vector<value_type> values = spread(50000, 1000000, 7);
+    log_histogram whole(1, 1000000, 3), empty(1, 1000000, 3);
+    log_histogram parts[3] = { log_histogram(1, 1000000, 3), log_histogram(1, 1000000, 3),
+                               log_histogram(1, 1000000, 3) };
+
+    for (size_t i = 0; i < values.size( ); ++i)
+    {
+        whole.next(values[i]);
+        parts[(i < 100) ? 0 : (i < 30000) ? 1 : 2].next(values[i]);
+    }
+    if (!same_histogram(parts[0] + parts[1] + parts[2], whole)) return 0;
+    if (!same_histogram(parts[2] + (parts[1] + parts[0]), whole)) return 0;
+    if (!same_histogram(empty + whole, whole) || !same_histogram(whole + empty, whole)) return 0;
+    if (!same_histogram(empty + empty, empty)) return 0;
+
+    // Parts whose ranges do not overlap: the minimum and maximum come from
+    // different sides.
+    log_histogram low(1, 1000000, 3), high(1, 1000000, 3), both(1, 1000000, 3);
+    for (value_type v = 5; v < 50; ++v)
+    {
+        low.next(v);
+        high.next(v * 10000);
+        both.next(v);
+        both.next(v * 10000);
+    }
+    if (!same_histogram(high + low, both) || !same_histogram(low + high, both)) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // Values above highest count as highest, values below lowest share the
+    // first buckets, a single value is every percentile, and reset clears.
+    // Returns 20 if everything goes okay; otherwise returns 0.
+
+    log_histogram h(16, 100000, 2);
+    h.next(5000000);
+    if (h.length( ) != 1 || h.maximum( ) != 100000 || h.minimum( ) != 100000) return 0;
+    if (h.percentile(0.5) != 100000) return 0;
+    h.next(0);
+    h.next(3);
+    h.next(15);
+    if (h.minimum( ) != 0 || h.percentile(0.25) > 15) return 0;
+    if (h.percentile(0.75) > 15 || h.percentile(1) != 100000) return 0;
+
+    h.reset( );
+    if (h.length( ) != 0) return 0;
+    h.next(777);
+    for (double q = 0; q <= 1; q += 0.25)
+        if (h.percentile(q) != 777) return 0;
+    if (fabs(h.mean( ) - 777) > 777 * 0.01) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running log_histogram tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing percentiles against exact order statistics (50 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing the + operator against a single histogram (30 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing values outside the range and reset (20 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the log_histogram to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
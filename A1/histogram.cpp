@@ -0,0 +1,167 @@
+// FILE: histogram.cpp
+// brief Implementation of the log_histogram class.
+
+#include <cassert>   // Provides assert
+#include <cmath>     // Provides ceil, log2, pow
+#include "histogram.h"
+
+namespace CISP430_A1 {
+
+	namespace {
+		// Position of the highest set bit of v, plus one (0 for v == 0).
+		int bit_length(unsigned long long v) {
+			return v == 0 ? 0 : 64 - __builtin_clzll(v);
+		}
+	}
+
+	// Constructor: work out the bucket layout and allocate the counts
+	log_histogram::log_histogram(value_type lowest, value_type highest, int digits)
+		: lowest(lowest), highest(highest), digits(digits), total(0), tiniest(0), largest(0) {
+		assert(lowest >= 1);
+		assert(highest >= 2 * lowest);
+		assert(digits >= 1 && digits <= 5);
+
+		// Each bucket needs enough sub-buckets to tell apart values that
+		// differ in the last significant digit.
+		double single_unit_range = 2 * std::pow(10.0, digits);
+		int count_magnitude = int(std::ceil(std::log2(single_unit_range)));
+		half_count_magnitude = (count_magnitude > 1 ? count_magnitude : 1) - 1;
+		unit_magnitude = bit_length(lowest) - 1;
+		value_type sub_bucket_count = value_type(1) << (half_count_magnitude + 1);
+		sub_bucket_mask = (sub_bucket_count - 1) << unit_magnitude;
+
+		// Each further bucket doubles the range that can be tracked.
+		size_type bucket_count = 1;
+		value_type smallest_untrackable = sub_bucket_count << unit_magnitude;
+		while (smallest_untrackable <= highest) {
+			if (smallest_untrackable > (~value_type(0) >> 2)) {
+				++bucket_count;
+				break;
+			}
+			smallest_untrackable <<= 1;
+			++bucket_count;
+		}
+		counts.assign((bucket_count + 1) * (sub_bucket_count / 2), 0);
+	}
+
+	// Index of the sub-bucket that holds v
+	log_histogram::size_type log_histogram::index_of(value_type v) const {
+		int bucket = bit_length(v | sub_bucket_mask) - unit_magnitude - (half_count_magnitude + 1);
+		value_type sub_bucket = v >> (bucket + unit_magnitude);
+		return (size_type(bucket + 1) << half_count_magnitude)
+			+ size_type(sub_bucket) - (size_type(1) << half_count_magnitude);
+	}
+
+	// Count a value
+	void log_histogram::next(value_type v) {
+		if (v > highest) v = highest;
+		if (total == 0) {
+			tiniest = v;
+			largest = v;
+		}
+		else {
+			if (v < tiniest) tiniest = v;
+			if (v > largest) largest = v;
+		}
+		++counts[index_of(v)];
+		++total;
+	}
+
+	// Reset the histogram
+	void log_histogram::reset() {
+		total = 0;
+		tiniest = 0;
+		largest = 0;
+		counts.assign(counts.size(), 0);
+	}
+
+	// Return the smallest value counted
+	log_histogram::value_type log_histogram::minimum() const {
+		assert(total > 0);
+		return tiniest;
+	}
+
+	// Return the largest value counted
+	log_histogram::value_type log_histogram::maximum() const {
+		assert(total > 0);
+		return largest;
+	}
+
+	// Mean, taking each value as the middle of its sub-bucket
+	double log_histogram::mean() const {
+		assert(total > 0);
+		double sum = 0;
+		for (size_type i = 0; i < counts.size(); ++i) {
+			if (counts[i] > 0)
+				sum += counts[i] * (0.5 * lowest_at(i) + 0.5 * highest_at(i));
+		}
+		return sum / total;
+	}
+
+	// The q-quantile, reported as the top of its sub-bucket (but never more
+	// than the largest value actually counted)
+	log_histogram::value_type log_histogram::percentile(double q) const {
+		assert(total > 0);
+		assert(q >= 0 && q <= 1);
+		if (q == 0) return tiniest;
+
+		size_type target = size_type(std::ceil(q * total));
+		if (target == 0) target = 1;
+		size_type seen = 0;
+		for (size_type i = 0; i < counts.size(); ++i) {
+			seen += counts[i];
+			if (seen >= target) {
+				value_type top = highest_at(i);
+				return top < largest ? top : largest;
+			}
+		}
+		return largest;
+	}
+
+	// Count in sub-bucket i
+	log_histogram::size_type log_histogram::count_at(size_type i) const {
+		assert(i < counts.size());
+		return counts[i];
+	}
+
+	// Smallest value that belongs to sub-bucket i
+	log_histogram::value_type log_histogram::lowest_at(size_type i) const {
+		assert(i < counts.size());
+		size_type half_count = size_type(1) << half_count_magnitude;
+		long bucket = long(i >> half_count_magnitude) - 1;
+		size_type sub_bucket = (i & (half_count - 1)) + half_count;
+		if (bucket < 0) {
+			sub_bucket -= half_count;
+			bucket = 0;
+		}
+		return value_type(sub_bucket) << (bucket + unit_magnitude);
+	}
+
+	// Largest value that belongs to sub-bucket i
+	log_histogram::value_type log_histogram::highest_at(size_type i) const {
+		assert(i < counts.size());
+		long bucket = long(i >> half_count_magnitude) - 1;
+		if (bucket < 0) bucket = 0;
+		return lowest_at(i) + (value_type(1) << (bucket + unit_magnitude)) - 1;
+	}
+
+	// Overload the + operator to merge two histograms
+	log_histogram operator+(const log_histogram& h1, const log_histogram& h2) {
+		assert(h1.lowest == h2.lowest && h1.highest == h2.highest && h1.digits == h2.digits);
+		log_histogram result(h1);
+
+		result.total = h1.total + h2.total;
+		if (h1.total == 0) {
+			result.tiniest = h2.tiniest;
+			result.largest = h2.largest;
+		}
+		else if (h2.total > 0) {
+			if (h2.tiniest < result.tiniest) result.tiniest = h2.tiniest;
+			if (h2.largest > result.largest) result.largest = h2.largest;
+		}
+		for (log_histogram::size_type i = 0; i < result.counts.size(); ++i)
+			result.counts[i] += h2.counts[i];
+		return result;
+	}
+
+} // namespace CISP430_A1
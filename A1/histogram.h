@@ -0,0 +1,123 @@
+// FILE: histogram.h
+// CLASS PROVIDED: log_histogram
+//   (a fixed-size histogram of non-negative integers, such as latencies in
+//   microseconds, with a bounded relative error, as a companion to the
+//   statistician class)
+//   This class is part of the namespace CISP430_A1.
+//
+//   The layout is the one used by HdrHistogram: the range of values is cut
+//   into buckets at powers of two, and each bucket is cut into the same
+//   number of equal sub-buckets, enough for the requested number of
+//   significant decimal digits. Every value recorded is counted in the
+//   sub-bucket that contains it, so any value read back (a percentile or a
+//   bucket bound) is within one part in 10^digits of a recorded value. All
+//   the memory is allocated by the constructor; each extra digit costs
+//   about eight times as much (26 KB for the default 1 to 3.6e9 range with
+//   2 digits, 184 KB with 3 digits).
+//
+// TYPEDEFS for the log_histogram class:
+//   typedef ____ value_type
+//     log_histogram::value_type is the (unsigned integer) type of the values.
+//   typedef ____ size_type
+//     log_histogram::size_type is the data type of counts and bucket numbers.
+//
+// CONSTRUCTOR for the log_histogram class:
+//   log_histogram(value_type lowest = 1, value_type highest = 3600000000,
+//                 int digits = 2)
+//     Precondition: lowest >= 1, highest >= 2 * lowest, 1 <= digits <= 5.
+//     Postcondition: The histogram is empty. Values from 0 to highest can be
+//     recorded; values below lowest share one bucket with zero, and digits
+//     is the number of significant decimal digits kept for every value.
+//
+// PUBLIC MODIFICATION member functions for the log_histogram class:
+//   void next(value_type v)
+//     Postcondition: The value v has been counted. (Values larger than
+//     highest are counted as highest.) This takes constant time and never
+//     allocates memory.
+//   void reset( )
+//     Postcondition: The histogram has been cleared.
+//
+// PUBLIC CONSTANT member functions for the log_histogram class:
+//   size_type length( ) const
+//     Postcondition: The return value is how many values have been counted.
+//   value_type minimum( ) const, value_type maximum( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the exact smallest (or largest)
+//     value counted.
+//   double mean( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the mean of the values, taking
+//     each value as the middle of its sub-bucket.
+//   value_type percentile(double q) const
+//     Precondition: length( ) > 0 and 0 <= q <= 1.
+//     Postcondition: The return value is the q-quantile of the values
+//     counted (q = 0.99 for the 99th percentile), reported as the highest
+//     value that shares a sub-bucket with it.
+//   size_type buckets( ) const
+//     Postcondition: The return value is the number of sub-buckets.
+//   size_type count_at(size_type i) const
+//   value_type lowest_at(size_type i) const
+//   value_type highest_at(size_type i) const
+//     Precondition: i < buckets( )
+//     Postcondition: The return value is the number of values counted in
+//     sub-bucket i, or the smallest or largest value that belongs to it.
+//     The sub-buckets are in increasing order of value.
+//
+// NON-MEMBER functions for the log_histogram class:
+//   log_histogram operator +(const log_histogram& h1, const log_histogram& h2)
+//     Precondition: h1 and h2 were constructed with the same arguments.
+//     Postcondition: The histogram that is returned counts all the values
+//     of h1 and h2.
+//
+// VALUE SEMANTICS for the log_histogram class:
+// Assignments and the copy constructor may be used with log_histogram objects.
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+#include <cstdlib>   // Provides size_t
+#include <vector>    // Provides vector for the counts
+
+namespace CISP430_A1
+{
+    class log_histogram
+    {
+    public:
+        // TYPEDEFS
+        typedef unsigned long long value_type;
+        typedef std::size_t size_type;
+        // CONSTRUCTOR
+        log_histogram(value_type lowest = 1, value_type highest = 3600000000ULL,
+            int digits = 2);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(value_type v);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        size_type length( ) const { return total; }
+        value_type minimum( ) const;
+        value_type maximum( ) const;
+        double mean( ) const;
+        value_type percentile(double q) const;
+        size_type buckets( ) const { return counts.size( ); }
+        size_type count_at(size_type i) const;
+        value_type lowest_at(size_type i) const;
+        value_type highest_at(size_type i) const;
+        // FRIEND FUNCTIONS
+        friend log_histogram operator +
+            (const log_histogram& h1, const log_histogram& h2);
+    private:
+        value_type lowest;          // Arguments given to the constructor
+        value_type highest;
+        int digits;
+        int unit_magnitude;         // log2 of the width of the finest sub-bucket
+        int half_count_magnitude;   // log2 of half the sub-buckets per bucket
+        value_type sub_bucket_mask; // Bits that select a sub-bucket in bucket 0
+        size_type total;            // How many values have been counted
+        value_type tiniest;         // The smallest value counted
+        value_type largest;         // The largest value counted
+        std::vector<size_type> counts;  // Count for each sub-bucket
+        // HELPER MEMBER FUNCTIONS
+        size_type index_of(value_type v) const;
+    };
+}
+
+#endif
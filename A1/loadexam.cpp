@@ -0,0 +1,231 @@
+// FILE: loadexam.cpp
+
+// This program calls three test functions to test load_samples and
+// summarize_samples on files and arrays in each sample_format, comparing
+// them with statistician::from_range on the same numbers converted to
+// double.
+// Maximum number of points from this program is 100.
+// (Link with -pthread. It writes and then removes the file loadexam.tmp.)
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+#include "statload.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 40, SCORE3 = 20;
+const char FILENAME[ ] = "loadexam.tmp";
+const sample_format FORMATS[ ] = { SAMPLE_DOUBLE, SAMPLE_FLOAT, SAMPLE_INT32, SAMPLE_INT64 };
+const size_t COUNTS[ ] = { 0, 1, 2, 511, 513, 65536 * 2 - 1, 65536 * 3 + 7 };
+const unsigned THREADS[ ] = { 0, 1, 2, 3, 8 };
+
+// Are a and b the same in every statistic, not just those == compares?
+bool identical(const statistician& a, const statistician& b)
+{
+    if (a.length( ) != b.length( )) return false;
+    if (a.length( ) == 0) return true;
+    return a.sum( ) == b.sum( ) && a.minimum( ) == b.minimum( )
+        && a.maximum( ) == b.maximum( ) && a.variance( ) == b.variance( )
+        && a.skewness( ) == b.skewness( ) && a.kurtosis( ) == b.kurtosis( );
+}
+
+// count numbers in the given format, in the machine's own byte order
+// (little-endian here), written to bytes; numbers gets each as a double.
+void make_samples(sample_format format, size_t count,
+                  vector<unsigned char>& bytes, vector<double>& numbers)
+{
+    bytes.clear( );
+    numbers.clear( );
+    for (size_t i = 0; i < count; ++i)
+    {
+        long long whole = (long long)((i * 2654435761ULL) % 4000037) - 2000000;
+        double value;
+        unsigned char raw[8];
+        size_t size;
+        if (format == SAMPLE_DOUBLE)
+        {
+            value = whole / 7.0;
+            memcpy(raw, &value, size = 8);
+        }
+        else if (format == SAMPLE_FLOAT)
+        {
+            float f = float(whole / 7.0);
+            value = f;
+            memcpy(raw, &f, size = 4);
+        }
+        else if (format == SAMPLE_INT32)
+        {
+            int32_t n = int32_t(whole * 1000);
+            value = n;
+            memcpy(raw, &n, size = 4);
+        }
+        else
+        {
+            int64_t n = whole * 1000000007LL;
+            value = double(n);
+            memcpy(raw, &n, size = 8);
+        }
+        bytes.insert(bytes.end( ), raw, raw + size);
+        numbers.push_back(value);
+    }
+}
+
+// What from_range gives for the numbers with the given thread count
+statistician expected(const vector<double>& numbers, unsigned threads)
+{
+    const double* first = numbers.empty( ) ? 0 : &numbers[0];
+    return statistician::from_range(first, first + numbers.size( ), threads);
+}
+
+bool write_file(const vector<unsigned char>& bytes)
+{
+    FILE* out = fopen(FILENAME, "wb");
+    if (out == NULL) return false;
+    bool okay = bytes.empty( ) || fwrite(&bytes[0], 1, bytes.size( ), out) == bytes.size( );
+    return (fclose(out) == 0) && okay;
+}
+
+int test1( )
+{
+    // summarize_samples on arrays of every format and length, aligned and
+    // not, must equal from_range on the converted numbers with the same
+    // number of threads (and so split them into the same pieces).
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    vector<unsigned char> bytes, shifted;
+    vector<double> numbers;
+
+    for (size_t f = 0; f < sizeof(FORMATS) / sizeof(FORMATS[0]); ++f)
+    {
+        for (size_t c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); ++c)
+        {
+            make_samples(FORMATS[f], COUNTS[c], bytes, numbers);
+            shifted.assign(1, 0);
+            shifted.insert(shifted.end( ), bytes.begin( ), bytes.end( ));
+            for (size_t t = 0; t < sizeof(THREADS) / sizeof(THREADS[0]); ++t)
+            {
+                statistician want = expected(numbers, THREADS[t]);
+                if (want.length( ) != (long long)(COUNTS[c])) return 0;
+                statistician got = summarize_samples(bytes.data( ), COUNTS[c], FORMATS[f], THREADS[t]);
+                if (!identical(got, want)) return 0;
+                got = summarize_samples(shifted.data( ) + 1, COUNTS[c], FORMATS[f], THREADS[t]);
+                if (!identical(got, want)) return 0;
+            }
+        }
+    }
+    return SCORE1;
+}
+
+int test2( )
+{
+    // load_samples on files of every format and length (including empty
+    // and one-number files, and files with a few extra bytes at the end).
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    vector<unsigned char> bytes;
+    vector<double> numbers;
+
+    for (size_t f = 0; f < sizeof(FORMATS) / sizeof(FORMATS[0]); ++f)
+    {
+        for (size_t c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); ++c)
+        {
+            make_samples(FORMATS[f], COUNTS[c], bytes, numbers);
+            for (int extra = 0; extra < 4; extra += 3)
+            {
+                vector<unsigned char> contents(bytes);
+                contents.insert(contents.end( ), extra, 0xff);
+                if (!write_file(contents)) return 0;
+                for (size_t t = 0; t < sizeof(THREADS) / sizeof(THREADS[0]); ++t)
+                {
+                    statistician got;
+                    got.next(12345);   // load_samples replaces what was there
+                    if (!load_samples(FILENAME, FORMATS[f], got, THREADS[t])) return 0;
+                    if (!identical(got, expected(numbers, THREADS[t]))) return 0;
+                }
+            }
+        }
+    }
+    remove(FILENAME);
+
+    // One number of each format, checked by value
+    make_samples(SAMPLE_INT64, 3, bytes, numbers);
+    bytes.resize(8);
+    if (!write_file(bytes)) return 0;
+    statistician one;
+    if (!load_samples(FILENAME, SAMPLE_INT64, one)) return 0;
+    if (one.length( ) != 1 || one.sum( ) != numbers[0]) return 0;
+    if (one.minimum( ) != numbers[0] || one.maximum( ) != numbers[0]) return 0;
+    // The same 8 bytes are two 32-bit numbers.
+    if (!load_samples(FILENAME, SAMPLE_INT32, one) || one.length( ) != 2) return 0;
+    remove(FILENAME);
+    return SCORE2;
+}
+
+int test3( )
+{
+    // A missing file leaves the result unchanged, and known numbers come
+    // out as written in each format.
+    // Returns 20 if everything goes okay; otherwise returns 0.
+
+    statistician kept;
+    kept.next(4);
+    remove(FILENAME);
+    if (load_samples(FILENAME, SAMPLE_DOUBLE, kept)) return 0;
+    if (kept.length( ) != 1 || kept.sum( ) != 4) return 0;
+
+    const double d[ ] = { -1.5, 2.25, 1e300 };
+    const float fl[ ] = { -1.5f, 0.25f, 3e38f };
+    const int32_t i32[ ] = { -2147483647 - 1, 7, 2147483647 };
+    const int64_t i64[ ] = { -(1LL << 62), 9, (1LL << 53) };
+    statistician s;
+
+    s = summarize_samples(d, 3, SAMPLE_DOUBLE);
+    if (s.minimum( ) != -1.5 || s.maximum( ) != 1e300) return 0;
+    s = summarize_samples(fl, 3, SAMPLE_FLOAT);
+    if (s.minimum( ) != -1.5 || s.maximum( ) != double(3e38f) || s.length( ) != 3) return 0;
+    s = summarize_samples(i32, 3, SAMPLE_INT32);
+    if (s.minimum( ) != -2147483648.0 || s.maximum( ) != 2147483647.0 || s.sum( ) != 6) return 0;
+    s = summarize_samples(i64, 3, SAMPLE_INT64);
+    if (s.minimum( ) != -4611686018427387904.0 || s.maximum( ) != 9007199254740992.0) return 0;
+    s = summarize_samples(i64, 0, SAMPLE_INT64, 4);
+    if (s.length( ) != 0) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running load_samples and summarize_samples tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing summarize_samples against from_range (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing load_samples on files of each format (40 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing a missing file and known numbers (20 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the load functions to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
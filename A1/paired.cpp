@@ -0,0 +1,128 @@
+// FILE: paired.cpp
+// brief Implementation of the paired_statistician class.
+
+#include <cassert>   // Provides assert
+#include <cmath>     // Provides sqrt
+#include "paired.h"
+
+namespace CISP430_A1 {
+
+	// Constructor
+	paired_statistician::paired_statistician()
+		: count(0), center_x(0.0), center_y(0.0), m2x(0.0), m2y(0.0), cxy(0.0) {}
+
+	// Add a pair
+	void paired_statistician::next(double x, double y) {
+		++count;
+		double dx = x - center_x;
+		double dy = y - center_y;
+		center_x += dx / count;
+		center_y += dy / count;
+		// One old and one new distance from the mean in each product
+		m2x += dx * (x - center_x);
+		m2y += dy * (y - center_y);
+		cxy += dx * (y - center_y);
+	}
+
+	// Add n pairs, a chunk at a time: each chunk is summarized on its own
+	// (two passes over data in the L1 cache) and then merged
+	void paired_statistician::next_batch(const double* x, const double* y, std::size_t n) {
+		const std::size_t CHUNK = 1024;
+		for (std::size_t start = 0; start < n; start += CHUNK) {
+			std::size_t k = (n - start < CHUNK) ? n - start : CHUNK;
+			const double* px = x + start;
+			const double* py = y + start;
+
+			// The mean is found from the distances to the first pair, so a
+			// chunk whose x's (or y's) are all the same gets exactly that
+			// mean and no spread at all.
+			double x0 = px[0], y0 = py[0];
+			double sx = 0.0, sy = 0.0;
+			for (std::size_t i = 0; i < k; ++i) {
+				sx += px[i] - x0;
+				sy += py[i] - y0;
+			}
+			paired_statistician part;
+			part.count = (long long)(k);
+			part.center_x = x0 + sx / k;
+			part.center_y = y0 + sy / k;
+			for (std::size_t i = 0; i < k; ++i) {
+				double dx = px[i] - part.center_x;
+				double dy = py[i] - part.center_y;
+				part.m2x += dx * dx;
+				part.m2y += dy * dy;
+				part.cxy += dx * dy;
+			}
+			*this = *this + part;
+		}
+	}
+
+	// Reset the statistician
+	void paired_statistician::reset() {
+		*this = paired_statistician();
+	}
+
+	double paired_statistician::mean_x() const {
+		assert(count > 0);
+		return center_x;
+	}
+
+	double paired_statistician::mean_y() const {
+		assert(count > 0);
+		return center_y;
+	}
+
+	double paired_statistician::variance_x() const {
+		assert(count > 0);
+		return m2x / count;
+	}
+
+	double paired_statistician::variance_y() const {
+		assert(count > 0);
+		return m2y / count;
+	}
+
+	double paired_statistician::covariance() const {
+		assert(count > 0);
+		return cxy / count;
+	}
+
+	// Pearson's correlation (zero when either variable is constant)
+	double paired_statistician::correlation() const {
+		assert(count > 0);
+		if (m2x == 0 || m2y == 0) return 0.0;
+		return cxy / std::sqrt(m2x * m2y);
+	}
+
+	// Least-squares slope
+	double paired_statistician::slope() const {
+		assert(count > 0);
+		assert(m2x > 0);
+		return cxy / m2x;
+	}
+
+	// Least-squares intercept
+	double paired_statistician::intercept() const {
+		return center_y - slope() * center_x;
+	}
+
+	// Overload the + operator: Chan's pairwise update of the co-moments
+	paired_statistician operator+(const paired_statistician& s1, const paired_statistician& s2) {
+		if (s1.count == 0) return s2;
+		if (s2.count == 0) return s1;
+
+		paired_statistician result;
+		double na = double(s1.count), nb = double(s2.count);
+		double n = na + nb;
+		double dx = s2.center_x - s1.center_x;
+		double dy = s2.center_y - s1.center_y;
+		result.count = s1.count + s2.count;
+		result.center_x = s1.center_x + dx * nb / n;
+		result.center_y = s1.center_y + dy * nb / n;
+		result.m2x = s1.m2x + s2.m2x + dx * dx * na * nb / n;
+		result.m2y = s1.m2y + s2.m2y + dy * dy * na * nb / n;
+		result.cxy = s1.cxy + s2.cxy + dx * dy * na * nb / n;
+		return result;
+	}
+
+} // namespace CISP430_A1
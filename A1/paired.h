@@ -0,0 +1,95 @@
+// FILE: paired.h
+// CLASS PROVIDED: paired_statistician
+//   (a class to keep track of statistics on a sequence of pairs of
+//   numbers (x, y): the means, variances, covariance, correlation and
+//   least-squares line)
+//   This class is part of the namespace CISP430_A1.
+//
+//   The means and the sums of squared and cross-multiplied distances from
+//   the means are updated as each pair arrives (Welford's method), so only
+//   one pass over the pairs is needed and nothing is stored. Two
+//   paired_statisticians combine with + (Chan's formulas), so a long trace
+//   can be split across threads just like a statistician.
+//
+// CONSTRUCTOR for the paired_statistician class:
+//   paired_statistician( )
+//     Postcondition: The object is empty.
+//
+// PUBLIC MODIFICATION member functions for the paired_statistician class:
+//   void next(double x, double y)
+//     Postcondition: The pair (x, y) has been given to the statistician.
+//   void next_batch(const double* x, const double* y, size_t n)
+//     Precondition: x and y each point to at least n numbers.
+//     Postcondition: The pairs (x[i], y[i]) for i = 0 to n-1 have been
+//     given to the statistician, as if by next.
+//   void reset( )
+//     Postcondition: The statistician has been cleared.
+//
+// PUBLIC CONSTANT member functions for the paired_statistician class:
+//   long long length( ) const
+//     Postcondition: The return value is how many pairs have been given.
+//   double mean_x( ) const, double mean_y( ) const
+//   double variance_x( ) const, double variance_y( ) const
+//   double covariance( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the mean of the x's or y's, the
+//     population variance of the x's or y's, or the population covariance
+//     of the pairs.
+//   double correlation( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is Pearson's correlation coefficient
+//     of the pairs, or zero if all the x's or all the y's are the same.
+//   double slope( ) const, double intercept( ) const
+//     Precondition: length( ) > 0, and the x's are not all the same.
+//     Postcondition: The return value is the slope or intercept of the
+//     least-squares line y = slope * x + intercept.
+//
+// NON-MEMBER functions for the paired_statistician class:
+//   paired_statistician operator +(const paired_statistician& s1,
+//                                  const paired_statistician& s2)
+//     Postcondition: The statistician that is returned contains all the
+//     pairs of s1 and s2.
+//
+// VALUE SEMANTICS for the paired_statistician class:
+// Assignments and the copy constructor may be used with paired_statistician
+// objects.
+
+#ifndef PAIRED_H
+#define PAIRED_H
+#include <cstdlib>   // Provides size_t
+
+namespace CISP430_A1
+{
+    class paired_statistician
+    {
+    public:
+        // CONSTRUCTOR
+        paired_statistician( );
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(double x, double y);
+        void next_batch(const double* x, const double* y, std::size_t n);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        long long length( ) const { return count; }
+        double mean_x( ) const;
+        double mean_y( ) const;
+        double variance_x( ) const;
+        double variance_y( ) const;
+        double covariance( ) const;
+        double correlation( ) const;
+        double slope( ) const;
+        double intercept( ) const;
+        // FRIEND FUNCTIONS
+        friend paired_statistician operator +
+            (const paired_statistician& s1, const paired_statistician& s2);
+    private:
+        long long count;    // How many pairs
+        double center_x;    // The running means
+        double center_y;
+        double m2x;         // Sum of squared distances of the x's from center_x
+        double m2y;         // Sum of squared distances of the y's from center_y
+        double cxy;         // Sum of (x - center_x) * (y - center_y)
+    };
+}
+
+#endif
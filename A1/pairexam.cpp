@@ -0,0 +1,226 @@
+// FILE: pairexam.cpp
+
+// This program calls three test functions to test the paired_statistician
+// class against a two-pass computation: pairs given with next and with
+// next_batch, statisticians combined with +, and streams in which the x's
+// or y's are all the same.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "paired.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 30, SCORE3 = 30;
+
+bool close(double a, double b, double tolerance)
+{
+    return (fabs(a-b) <= tolerance * (1 + fabs(b)));
+}
+
+// Pairs (x, y) around a large offset, with y partly following x
+void make_pairs(size_t n, double offset, unsigned long long seed,
+                vector<double>& x, vector<double>& y)
+{
+    unsigned long long state = seed;
+    x.clear( );
+    y.clear( );
+    for (size_t i = 0; i < n; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double u = double(state >> 11) / 9007199254740992.0 - 0.5;
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double v = double(state >> 11) / 9007199254740992.0 - 0.5;
+        x.push_back(offset + 100 * u);
+        y.push_back(-offset / 2 + 30 * u + 20 * v);
+    }
+}
+
+// Does s match a two-pass computation over x[first..last-1], y[first..last-1]?
+bool matches(const paired_statistician& s, const vector<double>& x, const vector<double>& y,
+             size_t first, size_t last)
+{
+    const double TOLERANCE = 1e-9;
+    size_t n = last - first;
+    if (s.length( ) != (long long)(n)) return false;
+    double mx = 0, my = 0;
+    for (size_t i = first; i < last; ++i)
+    {
+        mx += x[i];
+        my += y[i];
+    }
+    mx /= n;
+    my /= n;
+    double sxx = 0, syy = 0, sxy = 0;
+    for (size_t i = first; i < last; ++i)
+    {
+        sxx += (x[i] - mx) * (x[i] - mx);
+        syy += (y[i] - my) * (y[i] - my);
+        sxy += (x[i] - mx) * (y[i] - my);
+    }
+    if (!close(s.mean_x( ), mx, TOLERANCE) || !close(s.mean_y( ), my, TOLERANCE)) return false;
+    if (!close(s.variance_x( ), sxx / n, TOLERANCE)) return false;
+    if (!close(s.variance_y( ), syy / n, TOLERANCE)) return false;
+    if (!close(s.covariance( ), sxy / n, TOLERANCE)) return false;
+    if (!close(s.correlation( ), sxy / sqrt(sxx * syy), TOLERANCE)) return false;
+    if (!close(s.slope( ), sxy / sxx, TOLERANCE)) return false;
+    return close(s.intercept( ), my - sxy / sxx * mx, TOLERANCE);
+}
+
+int test1( )
+{
+    // next and next_batch against two passes, for lengths around the batch
+    // chunk and for numbers far from zero.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    const size_t LENGTHS[ ] = { 2, 3, 1023, 1024, 1025, 5000, 100000 };
+    const double OFFSETS[ ] = { 0, 1e3, 1e6 };
+    vector<double> x, y;
+
+    for (size_t k = 0; k < sizeof(LENGTHS) / sizeof(LENGTHS[0]); ++k)
+    {
+        for (size_t o = 0; o < sizeof(OFFSETS) / sizeof(OFFSETS[0]); ++o)
+        {
+            make_pairs(LENGTHS[k], OFFSETS[o], k * 3 + o + 1, x, y);
+            paired_statistician one, batch;
+            for (size_t i = 0; i < x.size( ); ++i)
+                one.next(x[i], y[i]);
+            batch.next_batch(x.data( ), y.data( ), x.size( ));
+            if (!matches(one, x, y, 0, x.size( ))) return 0;
+            if (!matches(batch, x, y, 0, x.size( ))) return 0;
+        }
+    }
+
+    // A perfect line
+    paired_statistician line;
+    for (int i = 0; i < 50; ++i)
+        line.next(i * 0.5, 3 * (i * 0.5) - 2);
+    if (!close(line.correlation( ), 1, 1e-12) || !close(line.slope( ), 3, 1e-12)) return 0;
+    if (!close(line.intercept( ), -2, 1e-12)) return 0;
+    paired_statistician falling;
+    for (int i = 0; i < 50; ++i)
+        falling.next(i, 7 - i);
+    if (!close(falling.correlation( ), -1, 1e-12)) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // The + of statisticians of parts of the pairs against two passes over
+    // all of them, for several places to cut and with empty parts.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    const size_t CUTS[ ] = { 0, 1, 17, 1024, 25000, 49999, 50000 };
+    vector<double> x, y;
+    make_pairs(50000, 1e6, 99, x, y);
+
+    for (size_t c = 0; c < sizeof(CUTS) / sizeof(CUTS[0]); ++c)
+    {
+        size_t cut = CUTS[c];
+        paired_statistician left, right;
+        for (size_t i = 0; i < cut; ++i)
+            left.next(x[i], y[i]);
+        right.next_batch(x.data( ) + cut, y.data( ) + cut, x.size( ) - cut);
+        if (!matches(left + right, x, y, 0, x.size( ))) return 0;
+        if (!matches(right + left, x, y, 0, x.size( ))) return 0;
+        if (cut > 1 && !matches(left, x, y, 0, cut)) return 0;
+    }
+
+    // Many small parts, combined in turn
+    paired_statistician total;
+    for (size_t start = 0; start < x.size( ); start += 333)
+    {
+        paired_statistician part;
+        size_t end = (start + 333 < x.size( )) ? start + 333 : x.size( );
+        part.next_batch(x.data( ) + start, y.data( ) + start, end - start);
+        total = total + part;
+    }
+    if (!matches(total, x, y, 0, x.size( ))) return 0;
+
+    paired_statistician empty;
+    if ((empty + empty).length( ) != 0) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // When the x's (or the y's) are all the same, their variance and the
+    // covariance are exactly zero and so is the correlation, however the
+    // pairs were given.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    const double CONSTANTS[ ] = { 0.1, -7, 1e9 + 0.3, 3.3e-5 };
+    vector<double> x, y;
+
+    for (size_t k = 0; k < sizeof(CONSTANTS) / sizeof(CONSTANTS[0]); ++k)
+    {
+        make_pairs(3000, 0, k + 5, x, y);
+        vector<double> same(x.size( ), CONSTANTS[k]);
+        paired_statistician one, batch, parts, flipped;
+        for (size_t i = 0; i < x.size( ); ++i)
+        {
+            one.next(same[i], y[i]);
+            flipped.next(x[i], same[i]);
+        }
+        batch.next_batch(same.data( ), y.data( ), same.size( ));
+        paired_statistician first, second;
+        first.next_batch(same.data( ), y.data( ), 1500);
+        second.next_batch(same.data( ) + 1500, y.data( ) + 1500, 1500);
+        parts = first + second;
+
+        const paired_statistician* all[ ] = { &one, &batch, &parts };
+        for (size_t j = 0; j < 3; ++j)
+        {
+            if (all[j]->mean_x( ) != CONSTANTS[k]) return 0;
+            if (all[j]->variance_x( ) != 0 || all[j]->covariance( ) != 0) return 0;
+            if (all[j]->correlation( ) != 0) return 0;
+            if (all[j]->variance_y( ) <= 0) return 0;
+        }
+        if (flipped.variance_y( ) != 0 || flipped.covariance( ) != 0) return 0;
+        if (flipped.correlation( ) != 0 || flipped.slope( ) != 0) return 0;
+        if (flipped.intercept( ) != CONSTANTS[k]) return 0;
+    }
+
+    paired_statistician single;
+    single.next(4, 5);
+    if (single.correlation( ) != 0 || single.covariance( ) != 0) return 0;
+    if (single.mean_x( ) != 4 || single.mean_y( ) != 5) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running paired_statistician tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing next and next_batch against two passes (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing the + operator against two passes (30 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing streams in which one variable is constant (30 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the paired_statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
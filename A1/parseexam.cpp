@@ -0,0 +1,236 @@
+// FILE: parseexam.cpp
+
+// This program calls three test functions to test scan_buffer, scan_text
+// and scan_file: which words are numbers, numbers cut by the end of a read
+// (at the 1 MB buffer and at the pieces a pipe delivers), and words too
+// long for the buffer.
+// Maximum number of points from this program is 100.
+// (Link with -pthread. It writes and then removes the file parseexam.tmp.)
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>     // Provides pipe, write, close
+#include "statparse.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 40, SCORE3 = 20;
+const char FILENAME[ ] = "parseexam.tmp";
+const size_t BUFFER = 1 << 20;    // The scanner's read size
+
+// Does s hold exactly the given numbers? Length, minimum and maximum must
+// be equal; the sum (added in another order) must be close.
+bool holds(const statistician& s, const vector<double>& numbers)
+{
+    if (s.length( ) != (long long)(numbers.size( ))) return false;
+    if (numbers.empty( )) return true;
+    double lo = numbers[0], hi = numbers[0], total = 0;
+    for (size_t i = 0; i < numbers.size( ); ++i)
+    {
+        if (numbers[i] < lo) lo = numbers[i];
+        if (numbers[i] > hi) hi = numbers[i];
+        total += numbers[i];
+    }
+    if (s.minimum( ) != lo || s.maximum( ) != hi) return false;
+    return fabs(s.sum( ) - total) <= 1e-9 * (1 + fabs(total));
+}
+
+bool scan_string(const string& text, statistician& s, scan_report& report)
+{
+    scan_buffer(text.data( ), text.data( ) + text.size( ), s, report);
+    return true;
+}
+
+bool write_file(const string& text)
+{
+    FILE* out = fopen(FILENAME, "wb");
+    if (out == NULL) return false;
+    bool okay = fwrite(text.data( ), 1, text.size( ), out) == text.size( );
+    return (fclose(out) == 0) && okay;
+}
+
+// Text of about size bytes: numbers of many shapes (appended to numbers)
+// and junk words (counted in junk), with assorted separators.
+string make_text(size_t size, vector<double>& numbers, unsigned long long& junk)
+{
+    const char* SEPARATORS[ ] = { " ", "\n", ",", "\t", " , ", "\r\n", ",,", "  \f" };
+    const char* JUNK[ ] = { "abc", "12abc", "1e", "--3", "0x1F", "1e999", "+-6", "." };
+    unsigned long long state = 8;
+    string text;
+    char word[64];
+
+    numbers.clear( );
+    junk = 0;
+    while (text.size( ) < size)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        unsigned r = unsigned(state >> 33);
+        if (r % 13 == 0)
+        {
+            text += JUNK[(r / 13) % 8];
+            ++junk;
+        }
+        else
+        {
+            double value;
+            switch (r % 5)
+            {
+            case 0: value = double(int(r % 200001) - 100000); snprintf(word, sizeof(word), "%.0f", value); break;
+            case 1: value = (int(r % 2001) - 1000) / 8.0; snprintf(word, sizeof(word), "%+.3f", value); break;
+            case 2: value = (int(r % 2001) - 1000) * 1e-7; snprintf(word, sizeof(word), "%.17g", value); break;
+            case 3: value = double(r % 999983) * 1e150; snprintf(word, sizeof(word), "%.17E", value); break;
+            default: value = (r % 1000) / 1024.0; snprintf(word, sizeof(word), "%.10f", value); break;
+            }
+            value = strtod(word, NULL);   // What the text really says
+            text += word;
+            numbers.push_back(value);
+        }
+        text += SEPARATORS[r % 8];
+    }
+    return text;
+}
+
+int test1( )
+{
+    // Which words are numbers: signs, exponents, inf and nan, and junk.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    statistician s;
+    scan_report report;
+    string text = "1 -2 +3 4.5e2 -1E-3 +0.25 .5 -.5e1 7. 1e+2 6E-0\n"
+                  "+-6 ++7 -+1 abc 12abc 1e 1e+ 0x10 1e400 - + . 3..4 1,2,,3\t4\r\n5";
+    scan_string(text, s, report);
+    double expected[ ] = { 1, -2, 3, 450, -0.001, 0.25, 0.5, -5, 7, 100, 6, 1, 2, 3, 4, 5 };
+    if (!holds(s, vector<double>(expected, expected + 16))) return 0;
+    if (report.skipped != 13 || report.bytes != text.size( )) return 0;
+
+    // Infinities and NaN (given after a number, so that NaN does not become
+    // the first minimum and maximum)
+    s.reset( );
+    text = "5 nan inf -Infinity NAN +inf -nan";
+    scan_string(text, s, report);
+    if (s.length( ) != 7 || report.skipped != 0) return 0;
+    if (s.minimum( ) != -INFINITY || s.maximum( ) != INFINITY) return 0;
+    if (!std::isnan(s.sum( ))) return 0;
+
+    // Empty text, only separators, and a number with no separator after it
+    s.reset( );
+    scan_string("", s, report);
+    if (s.length( ) != 0 || report.skipped != 0 || report.bytes != 0) return 0;
+    scan_string(" ,\n\t,", s, report);
+    if (s.length( ) != 0 || report.skipped != 0) return 0;
+    scan_string("-42", s, report);
+    if (s.length( ) != 1 || s.sum( ) != -42) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // Text longer than the buffer, with its start shifted so that numbers
+    // and junk words are cut by the end of each read at many places, read
+    // from a file and from a pipe that delivers small uneven pieces.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    vector<double> numbers;
+    unsigned long long junk;
+    string body = make_text(BUFFER * 5 / 2, numbers, junk);
+
+    for (size_t shift = 0; shift < 24; ++shift)
+    {
+        string text = string(shift, ' ') + body;
+        statistician from_file, from_buffer;
+        scan_report file_report, buffer_report;
+
+        if (!write_file(text)) return 0;
+        if (!scan_file(FILENAME, from_file, file_report)) return 0;
+        scan_string(text, from_buffer, buffer_report);
+        if (!holds(from_file, numbers) || file_report.skipped != junk) return 0;
+        if (file_report.bytes != text.size( )) return 0;
+        if (!(from_file == from_buffer) || buffer_report.skipped != junk) return 0;
+    }
+    remove(FILENAME);
+
+    // A pipe: the writer sends pieces of 1 to 4999 bytes.
+    int ends[2];
+    if (pipe(ends) != 0) return 0;
+    thread writer([&]( ) {
+        size_t sent = 0, piece = 1;
+        while (sent < body.size( ))
+        {
+            size_t n = min(piece, body.size( ) - sent);
+            ssize_t done = write(ends[1], body.data( ) + sent, n);
+            if (done <= 0) break;
+            sent += size_t(done);
+            piece = piece * 7 % 5000 + 1;
+        }
+        close(ends[1]);
+    });
+    statistician from_pipe;
+    scan_report pipe_report;
+    bool okay = scan_text(ends[0], from_pipe, pipe_report);
+    writer.join( );
+    close(ends[0]);
+    if (!okay || !holds(from_pipe, numbers)) return 0;
+    if (pipe_report.skipped != junk || pipe_report.bytes != body.size( )) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // Words too long for the buffer are skipped once each, the numbers
+    // around them still count, and a missing file is reported.
+    // Returns 20 if everything goes okay; otherwise returns 0.
+
+    string text = "1 2 " + string(BUFFER * 3 / 2, '9') + " 3 "
+                + string(BUFFER - 4, '7') + "\n4 " + string(BUFFER * 2, 'x') + ",5";
+    statistician s;
+    scan_report report;
+    if (!write_file(text)) return 0;
+    if (!scan_file(FILENAME, s, report)) return 0;
+    double expected[ ] = { 1, 2, 3, 4, 5 };
+    if (!holds(s, vector<double>(expected, expected + 5))) return 0;
+    if (report.skipped != 3 || report.bytes != text.size( )) return 0;
+
+    remove(FILENAME);
+    if (scan_file(FILENAME, s, report)) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running scan function tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing which words are numbers (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing numbers cut by the end of a read (40 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing words longer than the buffer (20 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the scan functions to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,92 @@
+// FILE: quantbench.cpp
+// A benchmark that compares the quantile_sketch class against sorting the
+// whole sequence. For several sequence lengths it reports the time per
+// number, the p50/p99/p999 estimates next to the exact values, and the
+// largest rank error seen over a grid of quantiles.
+//
+// Usage: quantbench [k]     (k is the sketch parameter, default 200)
+
+#include <algorithm>   // Provides sort, upper_bound
+#include <chrono>      // Provides steady_clock
+#include <cmath>       // Provides fabs
+#include <cstdlib>     // Provides EXIT_SUCCESS, atoi
+#include <iomanip>     // Provides setw, setprecision
+#include <iostream>    // Provides cout
+#include <random>      // Provides mt19937_64, lognormal_distribution
+#include <vector>
+#include "quantile.h"
+using namespace CISP430_A1;
+using namespace std;
+
+typedef chrono::steady_clock bench_clock;
+
+double elapsed_ns(bench_clock::time_point start, bench_clock::time_point stop)
+// Postcondition: The return value is the time between start and stop in
+// nanoseconds.
+{
+    return chrono::duration<double, nano>(stop - start).count( );
+}
+
+double exact_rank(const vector<double>& sorted, double x)
+// Precondition: sorted is in increasing order and not empty.
+// Postcondition: The return value is the fraction of sorted that is <= x.
+{
+    return double(upper_bound(sorted.begin( ), sorted.end( ), x) - sorted.begin( ))
+        / sorted.size( );
+}
+
+void run(size_t n, size_t k)
+// Postcondition: One line of results for a sequence of n latency-like
+// (lognormal) numbers has been written to cout.
+{
+    mt19937_64 generator(n);
+    lognormal_distribution<double> latency(3.0, 1.0);
+    vector<double> data(n);
+    for (size_t i = 0; i < n; ++i)
+        data[i] = latency(generator);
+
+    bench_clock::time_point start = bench_clock::now( );
+    quantile_sketch sketch(k);
+    for (size_t i = 0; i < n; ++i)
+        sketch.next(data[i]);
+    double p50 = sketch.quantile(0.5);
+    double p99 = sketch.quantile(0.99);
+    double p999 = sketch.quantile(0.999);
+    double sketch_ns = elapsed_ns(start, bench_clock::now( )) / n;
+
+    start = bench_clock::now( );
+    vector<double> sorted(data);
+    sort(sorted.begin( ), sorted.end( ));
+    double exact_ns = elapsed_ns(start, bench_clock::now( )) / n;
+
+    double worst = 0;
+    for (int i = 1; i < 1000; ++i)
+    {
+        double q = i / 1000.0;
+        double error = fabs(exact_rank(sorted, sketch.quantile(q)) - q);
+        if (error > worst) worst = error;
+    }
+
+    cout << setw(10) << n
+         << setw(10) << sketch.retained( )
+         << setw(11) << setprecision(3) << sketch_ns
+         << setw(11) << exact_ns
+         << setw(9) << p50 << " /" << setw(7) << sorted[size_t(0.5 * (n - 1))]
+         << setw(9) << p99 << " /" << setw(7) << sorted[size_t(0.99 * (n - 1))]
+         << setw(9) << p999 << " /" << setw(7) << sorted[size_t(0.999 * (n - 1))]
+         << setw(10) << setprecision(2) << 100 * worst << '%' << endl;
+}
+
+int main(int argc, char* argv[ ])
+{
+    size_t k = (argc > 1) ? size_t(atoi(argv[1])) : 200;
+
+    cout << "quantile_sketch with k = " << k << " against an exact sort\n";
+    cout << "         n  retained  sketch ns    sort ns"
+         << "       p50 (exact)         p99 (exact)        p999 (exact)"
+         << "  max rank err" << endl;
+    for (size_t n = 1000; n <= 10000000; n *= 10)
+        run(n, k);
+
+    return EXIT_SUCCESS;
+}
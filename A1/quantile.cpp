@@ -0,0 +1,197 @@
+// FILE: quantile.cpp
+// brief Implementation of the quantile_sketch class (a KLL sketch).
+
+#include <algorithm> // Provides sort, min, max
+#include <cassert>   // Provides assert
+#include <utility>   // Provides pair
+#include "quantile.h"
+
+namespace CISP430_A1 {
+
+	namespace {
+		// Each compactor below the top is this fraction of the one above it.
+		const double SHRINK = 2.0 / 3.0;
+		const std::size_t MIN_CAPACITY = 8;
+		const unsigned long long SEED = 0x9E3779B97F4A7C15ULL;
+	}
+
+	// Constructor
+	quantile_sketch::quantile_sketch(size_type k)
+		: k(k), count(0), tiniest(0.0), largest(0.0), stored(0), limit(0), coin(SEED) {
+		assert(k >= 8);
+		set_levels(1);
+		levels[0].reserve(k);
+	}
+
+	// Add a new number to the sequence
+	void quantile_sketch::next(double r) {
+		if (count == 0) {
+			tiniest = r;
+			largest = r;
+		}
+		else {
+			if (r < tiniest) tiniest = r;
+			if (r > largest) largest = r;
+		}
+		levels[0].push_back(r);
+		++count;
+		if (++stored >= limit)
+			compress();
+	}
+
+	// Reset the sketch
+	void quantile_sketch::reset() {
+		count = 0;
+		tiniest = 0.0;
+		largest = 0.0;
+		stored = 0;
+		coin = SEED;
+		levels.clear();
+		set_levels(1);
+		levels[0].reserve(k);
+	}
+
+	// Return the smallest number in the sequence
+	double quantile_sketch::minimum() const {
+		assert(count > 0);
+		return tiniest;
+	}
+
+	// Return the largest number in the sequence
+	double quantile_sketch::maximum() const {
+		assert(count > 0);
+		return largest;
+	}
+
+	// Estimate the q-quantile: the smallest stored item whose cumulative
+	// weight reaches q * length( )
+	double quantile_sketch::quantile(double q) const {
+		assert(count > 0);
+		assert(q >= 0 && q <= 1);
+		if (q == 0) return tiniest;
+		if (q == 1) return largest;
+
+		std::vector< std::pair<double, size_type> > items;
+		items.reserve(stored);
+		for (size_type h = 0; h < levels.size(); ++h)
+			for (size_type i = 0; i < levels[h].size(); ++i)
+				items.push_back(std::make_pair(levels[h][i], size_type(1) << h));
+		std::sort(items.begin(), items.end());
+
+		// Compaction keeps the total weight equal to count.
+		double target = q * count;
+		size_type seen = 0;
+		for (size_type i = 0; i < items.size(); ++i) {
+			seen += items[i].second;
+			if (seen >= target)
+				return std::min(std::max(items[i].first, tiniest), largest);
+		}
+		return largest;
+	}
+
+	// Estimate the fraction of numbers that are <= x
+	double quantile_sketch::rank(double x) const {
+		assert(count > 0);
+		size_type below = 0;
+		for (size_type h = 0; h < levels.size(); ++h)
+			for (size_type i = 0; i < levels[h].size(); ++i)
+				if (levels[h][i] <= x) below += size_type(1) << h;
+		return double(below) / count;
+	}
+
+	// Use the given number of levels. The top compactor holds k items and
+	// each one below it holds two thirds of the one above (but at least
+	// MIN_CAPACITY).
+	void quantile_sketch::set_levels(size_type height) {
+		levels.resize(height);
+		capacity.resize(height);
+		limit = 0;
+		double width = double(k);
+		for (size_type h = height; h > 0; --h) {
+			capacity[h - 1] = std::max(size_type(width + 0.5), MIN_CAPACITY);
+			limit += capacity[h - 1];
+			width *= SHRINK;
+		}
+	}
+
+	// Compact the lowest full compactor, and keep going until the sketch
+	// fits in its total capacity again.
+	void quantile_sketch::compress() {
+		while (stored >= limit) {
+			size_type h = 0;
+			while (levels[h].size() < capacity[h])
+				++h;
+			if (h + 1 == levels.size())
+				set_levels(levels.size() + 1);
+
+			std::vector<double>& from = levels[h];
+			std::vector<double>& to = levels[h + 1];
+			std::sort(from.begin(), from.end());
+
+			// An odd item out stays behind at its own level.
+			size_type start = from.size() % 2;
+
+			// xorshift64 step; the low bit picks the even or odd items
+			coin ^= coin << 13;
+			coin ^= coin >> 7;
+			coin ^= coin << 17;
+			size_type offset = size_type(coin & 1);
+
+			for (size_type i = start + offset; i < from.size(); i += 2)
+				to.push_back(from[i]);
+			stored -= (from.size() - start) / 2;
+			from.resize(start);
+		}
+	}
+
+	// Overload the + operator to merge two sketches
+	quantile_sketch operator+(const quantile_sketch& s1, const quantile_sketch& s2) {
+		quantile_sketch result(std::min(s1.k, s2.k));
+
+		result.count = s1.count + s2.count;
+		if (s1.count == 0) {
+			result.tiniest = s2.tiniest;
+			result.largest = s2.largest;
+		}
+		else if (s2.count == 0) {
+			result.tiniest = s1.tiniest;
+			result.largest = s1.largest;
+		}
+		else {
+			result.tiniest = std::min(s1.tiniest, s2.tiniest);
+			result.largest = std::max(s1.largest, s2.largest);
+		}
+		result.coin = s1.coin ^ (s2.coin << 1) ^ result.count;
+		if (result.coin == 0) result.coin = SEED;
+
+		result.set_levels(std::max(s1.levels.size(), s2.levels.size()));
+		result.stored = s1.stored + s2.stored;
+		for (quantile_sketch::size_type h = 0; h < result.levels.size(); ++h) {
+			std::vector<double>& level = result.levels[h];
+			if (h < s1.levels.size())
+				level.insert(level.end(), s1.levels[h].begin(), s1.levels[h].end());
+			if (h < s2.levels.size())
+				level.insert(level.end(), s2.levels[h].begin(), s2.levels[h].end());
+		}
+		result.compress();
+		return result;
+	}
+
+	// Overloaded * operator
+	quantile_sketch operator*(double scale, const quantile_sketch& s) {
+		quantile_sketch result(s);
+		for (quantile_sketch::size_type h = 0; h < result.levels.size(); ++h)
+			for (quantile_sketch::size_type i = 0; i < result.levels[h].size(); ++i)
+				result.levels[h][i] *= scale;
+		if (scale >= 0) {
+			result.tiniest = s.tiniest * scale;
+			result.largest = s.largest * scale;
+		}
+		else {
+			result.tiniest = s.largest * scale;
+			result.largest = s.tiniest * scale;
+		}
+		return result;
+	}
+
+} // namespace CISP430_A1
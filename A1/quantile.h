@@ -0,0 +1,116 @@
+// FILE: quantile.h
+// CLASS PROVIDED: quantile_sketch
+//   (a class to estimate quantiles of a sequence of real numbers in a fixed
+//   amount of memory, as a companion to the statistician class)
+//   This class is part of the namespace CISP430_A1.
+//
+//   The sketch is a KLL sketch (Karnin, Lang and Liberty, 2016): numbers are
+//   kept in a stack of "compactors". When a compactor fills up, it is sorted
+//   and every other number is promoted to the compactor above, where each
+//   number stands for twice as many originals. At most about 3k numbers are
+//   stored, whatever the length of the sequence.
+//
+// ERROR BOUND:
+//   The rank of the value returned by quantile(q), and the value returned by
+//   rank(x), are within about 1.7% of the exact rank for the default
+//   k = 200 with 99% confidence. The error shrinks roughly in proportion to
+//   1/k (about 0.35% for k = 1000). The minimum and maximum (q = 0 and
+//   q = 1) are always exact. quantbench.cpp measures the error and speed
+//   against sorting the whole sequence.
+//
+// TYPEDEFS for the quantile_sketch class:
+//   typedef ____ size_type
+//     quantile_sketch::size_type is the data type of any variable that keeps
+//     track of how many numbers the sketch has seen.
+//
+// CONSTRUCTOR for the quantile_sketch class:
+//   quantile_sketch(size_type k = 200)
+//     Precondition: k >= 8
+//     Postcondition: The sketch is empty and ready to accept numbers. Larger
+//     values of k use more memory and give smaller errors.
+//
+// PUBLIC MODIFICATION member functions for the quantile_sketch class:
+//   void next(double r)
+//     Postcondition: The number r has been given to the sketch as the next
+//     number in its sequence.
+//   void reset( )
+//     Postcondition: The sketch has been cleared, as if no numbers had yet
+//     been given to it.
+//
+// PUBLIC CONSTANT member functions for the quantile_sketch class:
+//   size_type length( ) const
+//     Postcondition: The return value is the number of numbers that have
+//     been given to the sketch.
+//   size_type retained( ) const
+//     Postcondition: The return value is the number of numbers the sketch
+//     is currently storing.
+//   double minimum( ) const, double maximum( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the exact smallest (or largest)
+//     number in the sequence.
+//   double quantile(double q) const
+//     Precondition: length( ) > 0 and 0 <= q <= 1.
+//     Postcondition: The return value is an estimate of the q-quantile of
+//     the sequence (for example, q = 0.99 estimates the 99th percentile).
+//   double rank(double x) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is an estimate of the fraction of the
+//     numbers in the sequence that are less than or equal to x.
+//
+// NON-MEMBER functions for the quantile_sketch class:
+//   quantile_sketch operator +(const quantile_sketch& s1, const quantile_sketch& s2)
+//     Postcondition: The sketch that is returned summarizes all the numbers
+//     of the sequences of s1 and s2. It uses the smaller of the two k values.
+//   quantile_sketch operator *(double scale, const quantile_sketch& s)
+//     Postcondition: The sketch that is returned summarizes the same numbers
+//     that s does, but each number has been multiplied by the scale number.
+//
+// VALUE SEMANTICS for the quantile_sketch class:
+// Assignments and the copy constructor may be used with quantile_sketch objects.
+
+#ifndef QUANTILE_H
+#define QUANTILE_H
+#include <cstdlib>   // Provides size_t
+#include <vector>    // Provides vector for the compactors
+
+namespace CISP430_A1
+{
+    class quantile_sketch
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        // CONSTRUCTOR
+        quantile_sketch(size_type k = 200);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(double r);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        size_type length( ) const { return count; }
+        size_type retained( ) const { return stored; }
+        double minimum( ) const;
+        double maximum( ) const;
+        double quantile(double q) const;
+        double rank(double x) const;
+        // FRIEND FUNCTIONS
+        friend quantile_sketch operator +
+            (const quantile_sketch& s1, const quantile_sketch& s2);
+        friend quantile_sketch operator *
+            (double scale, const quantile_sketch& s);
+    private:
+        size_type k;          // Capacity of the top compactor
+        size_type count;      // How many numbers in the sequence
+        double tiniest;       // The smallest number in the sequence
+        double largest;       // The largest number in the sequence
+        size_type stored;     // How many numbers are kept in the levels
+        size_type limit;      // Sum of the capacities of the levels
+        unsigned long long coin;  // State of the generator for compaction offsets
+        std::vector< std::vector<double> > levels;  // levels[h] items weigh 2^h
+        std::vector<size_type> capacity;            // Capacity of each level
+        // HELPER MEMBER FUNCTIONS
+        void set_levels(size_type height);
+        void compress( );
+    };
+}
+
+#endif
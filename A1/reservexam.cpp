@@ -0,0 +1,164 @@
+// FILE: reservexam.cpp
+
+// This program calls three test functions to test the reservoir class by
+// counting, over many seeds, how often each part of a stream is sampled.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "reservoir.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 20, SCORE2 = 40, SCORE3 = 40;
+const int TRIALS = 20000;
+const reservoir::size_type CAPACITY = 10;
+
+// Is the sample made of distinct whole numbers below limit? If so, count
+// each of them in the tenth of [0, limit) it falls in.
+bool count_tenths(const reservoir& r, long long limit, vector<long long>& tenths)
+{
+    vector<bool> seen(limit, false);
+    for (reservoir::size_type i = 0; i < r.size( ); ++i)
+    {
+        double item = r[i];
+        if (item < 0 || item >= limit || item != floor(item)) return false;
+        if (seen[(long long)(item)]) return false;
+        seen[(long long)(item)] = true;
+        ++tenths[(long long)(item) * 10 / limit];
+    }
+    return true;
+}
+
+// Was every tenth sampled as often as a uniform sample would be, give or
+// take 3% (more than four standard deviations)?
+bool uniform_tenths(const vector<long long>& tenths)
+{
+    double expected = double(TRIALS) * CAPACITY / 10;
+    for (size_t i = 0; i < tenths.size( ); ++i)
+    {
+        if (fabs(tenths[i] - expected) > 0.03 * expected) return false;
+    }
+    return true;
+}
+
+int test1( )
+{
+    // Until the reservoir is full, the sample is every number given.
+    // Returns 20 if everything goes okay; otherwise returns 0.
+
+    reservoir r(CAPACITY, 42);
+    vector<long long> tenths(10, 0);
+
+    if (r.capacity( ) != CAPACITY || r.size( ) != 0 || r.length( ) != 0) return 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        r.next(i);
+        if (r.length( ) != i + 1) return 0;
+        if (r.size( ) != ((i < int(CAPACITY)) ? reservoir::size_type(i + 1) : CAPACITY)) return 0;
+        if (i < int(CAPACITY) && r[i] != i) return 0;
+    }
+    if (!count_tenths(r, 1000, tenths)) return 0;
+
+    r.reset( );
+    if (r.length( ) != 0 || r.size( ) != 0) return 0;
+    r.next(5);
+    if (r.size( ) != 1 || r[0] != 5) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // Over many seeds, every tenth of a stream must be sampled equally often.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    vector<long long> tenths(10, 0);
+
+    for (int t = 0; t < TRIALS; ++t)
+    {
+        reservoir r(CAPACITY, t + 1);
+        for (int i = 0; i < 1000; ++i)
+            r.next(i);
+        if (r.size( ) != CAPACITY) return 0;
+        if (!count_tenths(r, 1000, tenths)) return 0;
+    }
+    if (!uniform_tenths(tenths)) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // The + of reservoirs of unequal parts of a stream must be a uniform
+    // sample of all of it, and must stay uniform as more numbers follow.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    vector<long long> merged(10, 0), continued(10, 0);
+
+    for (int t = 0; t < TRIALS; ++t)
+    {
+        reservoir r1(CAPACITY, 2 * t + 1), r2(CAPACITY, 2 * t + 2);
+        int i;
+        for (i = 0; i < 300; ++i)
+            r1.next(i);
+        for ( ; i < 1000; ++i)
+            r2.next(i);
+
+        reservoir both = (t % 2) ? r1 + r2 : r2 + r1;
+        if (both.length( ) != 1000 || both.size( ) != CAPACITY) return 0;
+        if (!count_tenths(both, 1000, merged)) return 0;
+
+        for ( ; i < 2000; ++i)
+            both.next(i);
+        if (both.length( ) != 2000 || both.size( ) != CAPACITY) return 0;
+        if (!count_tenths(both, 2000, continued)) return 0;
+    }
+    if (!uniform_tenths(merged)) return 0;
+    if (!uniform_tenths(continued)) return 0;
+
+    // Samples that are not yet full are merged whole.
+    reservoir small1(CAPACITY, 3), small2(CAPACITY, 4);
+    vector<long long> tenths(10, 0);
+    small1.next(0);
+    small1.next(1);
+    small2.next(2);
+    reservoir both = small1 + small2;
+    if (both.length( ) != 3 || both.size( ) != 3) return 0;
+    if (!count_tenths(both, 3, tenths)) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running reservoir tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing a reservoir that is not yet full (20 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing that every part of a stream is sampled equally (40 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing the + operator and numbers after it (40 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the reservoir to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
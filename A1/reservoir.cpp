@@ -0,0 +1,134 @@
+// FILE: reservoir.cpp
+// brief Implementation of the reservoir class.
+
+#include <cassert>   // Provides assert
+#include <cmath>     // Provides exp, floor, log, log1p
+#include <random>    // Provides gamma_distribution
+#include "reservoir.h"
+
+namespace CISP430_A1 {
+
+	namespace {
+
+		// xorshift64*: the next 64 random bits
+		unsigned long long random_bits(unsigned long long& state) {
+			state ^= state >> 12;
+			state ^= state << 25;
+			state ^= state >> 27;
+			return state * 0x2545F4914F6CDD1DULL;
+		}
+
+		// The same generator, in the form the <random> distributions want
+		struct bit_source {
+			typedef unsigned long long result_type;
+			unsigned long long& state;
+			static constexpr result_type min() { return 0; }
+			static constexpr result_type max() { return ~0ULL; }
+			result_type operator()() { return random_bits(state); }
+		};
+
+	}
+
+	// Constructor
+	reservoir::reservoir(size_type capacity, unsigned long long seed)
+		: limit(capacity), count(0), gap(0), w(1.0), state(seed != 0 ? seed : 1) {
+		assert(capacity > 0);
+		samples.reserve(capacity);
+	}
+
+	// A random number in (0, 1)
+	double reservoir::uniform() {
+		return (double(random_bits(state) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+	}
+
+	// A random index below n
+	reservoir::size_type reservoir::below(size_type n) {
+		size_type i = size_type(uniform() * n);
+		return i < n ? i : n - 1;
+	}
+
+	// Draw how many numbers to skip before the next one is sampled. w is the
+	// largest of the random keys of the sampled numbers (with every number
+	// given a uniform key, the sample is the limit numbers with the smallest
+	// keys), so each later number is sampled with probability w.
+	void reservoir::draw_gap() {
+		if (w >= 1.0) {
+			gap = 0;
+			return;
+		}
+		double skip = std::floor(std::log(uniform()) / std::log1p(-w));
+		gap = (skip < 9.0e18) ? (long long)(skip) : 9000000000000000000LL;
+	}
+
+	// Add a number
+	void reservoir::next(double r) {
+		++count;
+		if (samples.size() < limit) {
+			samples.push_back(r);
+			if (samples.size() == limit) {
+				w = std::exp(std::log(uniform()) / double(limit));
+				draw_gap();
+			}
+		}
+		else if (gap > 0) {
+			--gap;
+		}
+		else {
+			samples[below(limit)] = r;
+			w *= std::exp(std::log(uniform()) / double(limit));
+			draw_gap();
+		}
+	}
+
+	// Reset the reservoir
+	void reservoir::reset() {
+		count = 0;
+		gap = 0;
+		w = 1.0;
+		samples.clear();
+	}
+
+	// One sampled number
+	double reservoir::operator[](size_type i) const {
+		assert(i < samples.size());
+		return samples[i];
+	}
+
+	// Overload the + operator: draw the merged sample without replacement
+	reservoir operator+(const reservoir& r1, const reservoir& r2) {
+		assert(r1.limit == r2.limit);
+		reservoir result(r1.limit, r1.state ^ (r2.state << 1));
+		result.count = r1.count + r2.count;
+
+		// Unused numbers of each sample, and how many of the numbers given
+		// to each reservoir they still stand for
+		std::vector<double> left1(r1.samples), left2(r2.samples);
+		long long rest1 = r1.count, rest2 = r2.count;
+		reservoir::size_type want = result.limit;
+		if ((long long)(want) > result.count)
+			want = reservoir::size_type(result.count);
+
+		while (result.samples.size() < want) {
+			bool first = double(rest1) > result.uniform() * double(rest1 + rest2);
+			std::vector<double>& from = first ? left1 : left2;
+			reservoir::size_type i = result.below(from.size());
+			result.samples.push_back(from[i]);
+			from[i] = from.back();
+			from.pop_back();
+			if (first) --rest1;
+			else --rest2;
+		}
+
+		// For the numbers still to come, w must be distributed as the
+		// limit-th smallest of count uniform keys: Beta(limit, count - limit + 1).
+		if (result.samples.size() == result.limit) {
+			bit_source bits = { result.state };
+			double a = std::gamma_distribution<double>(double(result.limit))(bits);
+			double b = std::gamma_distribution<double>(double(result.count - (long long)(result.limit) + 1))(bits);
+			result.w = a / (a + b);
+			result.draw_gap();
+		}
+		return result;
+	}
+
+} // namespace CISP430_A1
@@ -0,0 +1,99 @@
+// FILE: reservoir.h
+// CLASS PROVIDED: reservoir
+//   (a fixed-size uniform random sample of a sequence of numbers, to keep
+//   next to a statistician so that there are real numbers to look at when
+//   its statistics show something unusual)
+//   This class is part of the namespace CISP430_A1.
+//
+//   The sample is kept with Li's Algorithm L (1994). Once the reservoir is
+//   full, the position of the next number to be sampled is drawn directly
+//   (the gap between sampled numbers), so for a long sequence almost every
+//   call to next only counts down the gap and draws no random numbers. At
+//   every moment each number given so far is in the sample with the same
+//   probability, capacity / length( ). All memory is allocated by the
+//   constructor.
+//
+//   To sample alongside a statistician, give each number to both; to merge,
+//   combine the statisticians and the reservoirs with +.
+//
+// TYPEDEFS for the reservoir class:
+//   typedef ____ size_type
+//     reservoir::size_type is the data type of the sample size.
+//
+// CONSTRUCTOR for the reservoir class:
+//   reservoir(size_type capacity = 100, unsigned long long seed = 1)
+//     Precondition: capacity > 0
+//     Postcondition: The reservoir is empty. It will keep at most capacity
+//     numbers, chosen with a random number generator started from seed.
+//
+// PUBLIC MODIFICATION member functions for the reservoir class:
+//   void next(double r)
+//     Postcondition: The number r has been given to the reservoir (and may
+//     have replaced one of the sampled numbers).
+//   void reset( )
+//     Postcondition: The reservoir has been cleared (the generator is not
+//     restarted).
+//
+// PUBLIC CONSTANT member functions for the reservoir class:
+//   long long length( ) const
+//     Postcondition: The return value is how many numbers have been given.
+//   size_type size( ) const
+//     Postcondition: The return value is how many numbers are in the sample
+//     (the smaller of length( ) and capacity( )).
+//   size_type capacity( ) const
+//     Postcondition: The return value is the capacity.
+//   double operator [ ](size_type i) const
+//     Precondition: i < size( )
+//     Postcondition: The return value is sampled number i. (The order of
+//     the sample has no meaning.)
+//
+// NON-MEMBER functions for the reservoir class:
+//   reservoir operator +(const reservoir& r1, const reservoir& r2)
+//     Precondition: r1 and r2 have the same capacity.
+//     Postcondition: The reservoir that is returned is a uniform sample of
+//     the numbers of both: its numbers are drawn without replacement from
+//     the two samples, each draw taking from r1 or r2 in proportion to how
+//     many of their numbers have not yet been drawn.
+//
+// VALUE SEMANTICS for the reservoir class:
+// Assignments and the copy constructor may be used with reservoir objects.
+
+#ifndef RESERVOIR_H
+#define RESERVOIR_H
+#include <cstdlib>   // Provides size_t
+#include <vector>    // Provides vector for the sample
+
+namespace CISP430_A1
+{
+    class reservoir
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        // CONSTRUCTOR
+        reservoir(size_type capacity = 100, unsigned long long seed = 1);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(double r);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        long long length( ) const { return count; }
+        size_type size( ) const { return samples.size( ); }
+        size_type capacity( ) const { return limit; }
+        double operator [ ](size_type i) const;
+        // FRIEND FUNCTIONS
+        friend reservoir operator +(const reservoir& r1, const reservoir& r2);
+    private:
+        size_type limit;              // The capacity
+        long long count;              // How many numbers have been given
+        long long gap;                // Numbers to skip before the next one is sampled
+        double w;                     // Algorithm L's running threshold
+        unsigned long long state;     // State of the random number generator
+        std::vector<double> samples;  // The sample
+        // HELPER MEMBER FUNCTIONS
+        double uniform( );
+        size_type below(size_type n);
+        void draw_gap( );
+    };
+}
+
+#endif
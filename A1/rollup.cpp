@@ -0,0 +1,162 @@
+// FILE: rollup.cpp
+// brief Implementation of the rollup_statistician class.
+//
+// INVARIANT for the rollup_statistician class:
+//   1. rings[0], rings[1] and rings[2] have buckets of 1, 60 and 3600
+//      seconds. Bucket number b of a ring covers the seconds from b * span
+//      to (b + 1) * span - 1, and is kept in buckets[b % buckets.size( )]
+//      for the buckets.size( ) numbers newest - buckets.size( ) + 1 through
+//      newest.
+//   2. Once started, rings[k + 1].newest is the bucket that contains the
+//      start of rings[k].newest.
+//   3. The newest second holds the numbers given for it. Every older
+//      bucket (and the newest minute and hour) has been given the numbers
+//      of the closed buckets below it: a minute holds its seconds up to
+//      but not including the newest second, and likewise for an hour.
+
+#include <cassert>   // Provides assert
+#include "rollup.h"
+
+namespace CISP430_A1 {
+
+	// Constructor: allocate the rings
+	rollup_statistician::rollup_statistician(size_type seconds, size_type minutes, size_type hours)
+		: is_started(false) {
+		assert(seconds >= 60);
+		assert(minutes >= 60);
+		assert(hours >= 1);
+		// Each ring reaches at least as far back as the finer one, so
+		// last( ) never finds a bucket older than the hour ring.
+		assert(minutes * 60 >= seconds);
+		assert(hours * 60 >= minutes);
+		const long long spans[LEVELS] = { 1, 60, 3600 };
+		const size_type sizes[LEVELS] = { seconds, minutes, hours };
+		for (int k = 0; k < LEVELS; ++k) {
+			rings[k].span = spans[k];
+			rings[k].newest = 0;
+			rings[k].buckets.resize(sizes[k]);
+		}
+	}
+
+	// The bucket that holds number (which must be in the ring)
+	statistician& rollup_statistician::bucket(ring& level, long long number) {
+		return level.buckets[size_type(number) % level.buckets.size()];
+	}
+
+	const statistician& rollup_statistician::bucket(const ring& level, long long number) {
+		return level.buckets[size_type(number) % level.buckets.size()];
+	}
+
+	// Is bucket number still in the ring?
+	bool rollup_statistician::holds(const ring& level, long long number) {
+		return number >= 0 && number <= level.newest
+			&& level.newest - number < (long long)(level.buckets.size());
+	}
+
+	// Close the newest bucket of level and move it on to number, recycling
+	// the buckets that fall off the end of the ring
+	void rollup_statistician::roll(int level, long long number) {
+		ring& r = rings[level];
+		if (number <= r.newest) return;
+
+		if (level + 1 < LEVELS) {
+			ring& up = rings[level + 1];
+			statistician& parent = bucket(up, up.newest);
+			parent = parent + bucket(r, r.newest);
+			roll(level + 1, number * r.span / up.span);
+		}
+
+		long long first = r.newest + 1;
+		if (number - first >= (long long)(r.buckets.size()))
+			first = number - (long long)(r.buckets.size()) + 1;
+		for (long long b = first; b <= number; ++b)
+			bucket(r, b).reset();
+		r.newest = number;
+	}
+
+	// Add a number at time now
+	void rollup_statistician::next(double r, long long now) {
+		advance(now);
+
+		// The number goes in the finest bucket that still covers it. If
+		// that bucket is closed, it has already been added to the one
+		// above, so the number is added there too, and so on up.
+		for (int k = 0; k < LEVELS; ++k) {
+			long long number = now / rings[k].span;
+			if (!holds(rings[k], number)) continue;
+			bucket(rings[k], number).next(r);
+			if (number == rings[k].newest) break;
+		}
+	}
+
+	// Move the clock on to now
+	void rollup_statistician::advance(long long now) {
+		assert(now >= 0);
+		if (!is_started) {
+			for (int k = 0; k < LEVELS; ++k)
+				rings[k].newest = now / rings[k].span;
+			is_started = true;
+		}
+		roll(0, now);
+	}
+
+	// Reset the rollup
+	void rollup_statistician::reset() {
+		for (int k = 0; k < LEVELS; ++k) {
+			for (size_type i = 0; i < rings[k].buckets.size(); ++i)
+				rings[k].buckets[i].reset();
+			rings[k].newest = 0;
+		}
+		is_started = false;
+	}
+
+	// The latest time seen
+	long long rollup_statistician::now() const {
+		assert(is_started);
+		return rings[0].newest;
+	}
+
+	// Statistics of the last seconds seconds
+	statistician rollup_statistician::last(long long seconds) const {
+		assert(is_started);
+		assert(seconds > 0);
+		long long from = rings[0].newest - seconds + 1;  // First second wanted
+		long long until = rings[0].newest + 1;           // Seconds before until are still wanted
+		statistician result;
+
+		// Take as much of the period as possible from each ring in turn.
+		// In each ring but the last, the newest end is walked back to a
+		// closed bucket of the next ring, and the oldest end is walked
+		// forward to a bucket boundary of the next ring (or, if this ring
+		// does not reach back that far, rounded out to one); what is left
+		// in between is whole buckets of the next ring.
+		if (from < 0) from = 0;
+		for (int k = 0; k < LEVELS && until > from; ++k) {
+			const ring& r = rings[k];
+			if (k + 1 == LEVELS) {
+				for ( ; until > from && holds(r, until / r.span - 1); until -= r.span)
+					result = result + bucket(r, until / r.span - 1);
+				break;
+			}
+
+			const ring& up = rings[k + 1];
+			while (until > from && holds(r, until / r.span - 1)
+				&& !(until % up.span == 0 && until / up.span - 1 < up.newest)) {
+				result = result + bucket(r, until / r.span - 1);
+				until -= r.span;
+			}
+
+			long long oldest = (r.newest - (long long)(r.buckets.size()) + 1) * r.span;
+			if (from >= oldest) {
+				while (until > from && from % up.span != 0) {
+					result = result + bucket(r, from / r.span);
+					from += r.span;
+				}
+			}
+			else
+				from -= from % up.span;
+		}
+		return result;
+	}
+
+} // namespace CISP430_A1
@@ -0,0 +1,110 @@
+// FILE: rollup.h
+// CLASS PROVIDED: rollup_statistician
+//   (statistics of a time-stamped sequence of numbers, kept per second, per
+//   minute and per hour, so that questions like "the last 5 minutes" are
+//   answered without looking at the numbers again)
+//   This class is part of the namespace CISP430_A1.
+//
+//   There are three rings of statisticians (buckets): one per second, one
+//   per minute and one per hour. A number is given only to the bucket of
+//   its second. When a second is over, its bucket is added (with +) to the
+//   bucket of its minute, and when a minute is over, the minute's bucket is
+//   added to the bucket of its hour. The rings are allocated once by the
+//   constructor; a bucket that falls off the end of its ring is reset and
+//   used again. A query combines at most one ring's worth of buckets from
+//   each ring, so its cost depends on the number of buckets, not on the
+//   number of numbers.
+//
+// TYPEDEFS for the rollup_statistician class:
+//   typedef ____ size_type
+//     rollup_statistician::size_type is the data type of the ring sizes.
+//
+// CONSTRUCTOR for the rollup_statistician class:
+//   rollup_statistician(size_type seconds = 300, size_type minutes = 120,
+//                       size_type hours = 48)
+//     Precondition: seconds >= 60, minutes >= 60 and hours >= 1, and each
+//     ring covers at least as much time as the finer one before it:
+//     minutes * 60 >= seconds and hours * 60 >= minutes.
+//     Postcondition: The rollup is empty. It will keep the given number of
+//     the most recent seconds, minutes and hours.
+//
+// PUBLIC MODIFICATION member functions for the rollup_statistician class:
+//   void next(double r, long long now)
+//     Precondition: now >= 0 (a time in seconds, such as time(NULL)).
+//     Postcondition: The number r has been given to the bucket of second
+//     now. If now is later than every earlier time, the clock has been
+//     moved to now (see advance). A number that is late is still counted,
+//     in the finest bucket that covers it; one older than the oldest hour
+//     kept is ignored.
+//   void advance(long long now)
+//     Precondition: now >= 0.
+//     Postcondition: If now is later than every earlier time, the buckets
+//     between the old time and now have been closed (and the seconds and
+//     minutes rolled up), so queries see that no numbers arrived meanwhile.
+//   void reset( )
+//     Postcondition: The rollup has been cleared.
+//
+// PUBLIC CONSTANT member functions for the rollup_statistician class:
+//   bool started( ) const
+//     Postcondition: The return value is true if next or advance has been
+//     activated since the rollup was constructed or reset.
+//   long long now( ) const
+//     Precondition: started( )
+//     Postcondition: The return value is the latest time given to next or
+//     advance.
+//   statistician last(long long seconds) const
+//     Precondition: started( ) and seconds > 0.
+//     Postcondition: The return value is a statistician that has been given
+//     the numbers of the last seconds seconds (up to and including now( )).
+//     The answer is exact to the second as far back as the second ring
+//     reaches. Beyond that, whole minutes are used (and beyond the minute
+//     ring, whole hours), so the period may be rounded out to the start of
+//     a minute or hour. Numbers older than the hour ring are not included.
+//
+// VALUE SEMANTICS for the rollup_statistician class:
+// Assignments and the copy constructor may be used with rollup_statistician
+// objects.
+
+#ifndef ROLLUP_H
+#define ROLLUP_H
+#include <cstdlib>   // Provides size_t
+#include <vector>    // Provides vector for the rings
+#include "stats.h"
+
+namespace CISP430_A1
+{
+    class rollup_statistician
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        // CONSTRUCTOR
+        rollup_statistician(size_type seconds = 300, size_type minutes = 120,
+            size_type hours = 48);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(double r, long long now);
+        void advance(long long now);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        bool started( ) const { return is_started; }
+        long long now( ) const;
+        statistician last(long long seconds) const;
+    private:
+        enum { LEVELS = 3 };       // Seconds, minutes, hours
+        struct ring
+        {
+            long long span;                  // Seconds per bucket
+            long long newest;                // Number of the newest bucket
+            std::vector<statistician> buckets;
+        };
+        ring rings[LEVELS];
+        bool is_started;
+        // HELPER MEMBER FUNCTIONS
+        static statistician& bucket(ring& level, long long number);
+        static const statistician& bucket(const ring& level, long long number);
+        static bool holds(const ring& level, long long number);
+        void roll(int level, long long number);
+    };
+}
+
+#endif
@@ -0,0 +1,175 @@
+// FILE: rollupexam.cpp
+
+// This program calls three test functions to test the rollup_statistician
+// class against a brute-force count of the same numbers.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "rollup.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 40, SCORE3 = 20;
+
+// The numbers given to a rollup, with their times, so that any period can
+// be counted the slow way
+struct timed
+{
+    long long when;
+    double value;
+};
+
+bool close(double a, double b)
+{
+    const double EPSILON = 1e-6;
+    return (fabs(a-b) < EPSILON * (1 + fabs(a)));
+}
+
+// Does s hold exactly the numbers given at times from..until-1?
+bool matches(const statistician& s, const vector<timed>& given, long long from, long long until)
+{
+    long long count = 0;
+    double total = 0, low = 0, high = 0;
+    for (size_t i = 0; i < given.size( ); ++i)
+    {
+        if (given[i].when < from || given[i].when >= until) continue;
+        if (count == 0 || given[i].value < low) low = given[i].value;
+        if (count == 0 || given[i].value > high) high = given[i].value;
+        total += given[i].value;
+        ++count;
+    }
+    if (s.length( ) != count) return false;
+    if (count == 0) return true;
+    return close(s.sum( ), total) && s.minimum( ) == low && s.maximum( ) == high;
+}
+
+// The first second that last(n) counts: exact while the second ring reaches,
+// then rounded out to the start of a minute, then of an hour
+long long rounded_from(long long now, long long n, long long seconds, long long minutes)
+{
+    long long from = now - n + 1;
+    if (from < 0) from = 0;
+    if (from >= now - seconds + 1) return from;
+    if (from >= (now / 60 - minutes + 1) * 60) return from - from % 60;
+    return from - from % 3600;
+}
+
+int test1( )
+{
+    // One number every second for t = 0..1037; every window that the second
+    // ring covers must be exact.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    rollup_statistician r;
+    vector<timed> given;
+    long long t;
+
+    for (t = 0; t <= 1037; ++t)
+    {
+        timed g = { t, double(t % 97) };
+        r.next(g.value, t);
+        given.push_back(g);
+    }
+    if (r.now( ) != 1037) return 0;
+    for (long long n = 1; n <= 300; ++n)
+        if (!matches(r.last(n), given, 1037 - n + 1, 1038)) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // Zero to three numbers a second with idle stretches, over more than two
+    // hours; windows in reach of the second ring are exact, longer ones are
+    // rounded out to a minute or an hour.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    rollup_statistician r(120, 60, 4);
+    vector<timed> given;
+    long long t;
+
+    for (t = 0; t <= 8000; ++t)
+    {
+        r.advance(t);
+        if ((t / 700) % 3 == 2) continue;        // Idle stretch
+        for (long long j = 0; j < (t * 7) % 4; ++j)
+        {
+            timed g = { t, double((t * 31 + j * 17) % 1000) - 500 };
+            r.next(g.value, t);
+            given.push_back(g);
+        }
+        if (t % 1111 == 0 || t == 8000)
+        {
+            for (long long n = 1; n <= t + 1; n += (n < 150 ? 1 : 37))
+                if (!matches(r.last(n), given, rounded_from(t, n, 120, 60), t + 1))
+                    return 0;
+        }
+    }
+    return SCORE2;
+}
+
+int test3( )
+{
+    // Moving the clock on without numbers: the numbers drop out of the
+    // short windows, and a late number is still counted.
+    // Returns 20 if everything goes okay; otherwise returns 0.
+
+    rollup_statistician r;
+    vector<timed> given;
+
+    for (long long t = 1000; t < 1100; ++t)
+    {
+        timed g = { t, double(t) };
+        r.next(g.value, t);
+        given.push_back(g);
+    }
+    r.advance(1150);
+    if (r.now( ) != 1150) return 0;
+    if (r.last(50).length( ) != 0) return 0;
+    for (long long n = 1; n <= 300; ++n)
+        if (!matches(r.last(n), given, 1150 - n + 1, 1151)) return 0;
+
+    timed late = { 1120, 7.5 };
+    r.next(late.value, late.when);
+    given.push_back(late);
+    if (r.now( ) != 1150) return 0;
+    for (long long n = 1; n <= 300; ++n)
+        if (!matches(r.last(n), given, 1150 - n + 1, 1151)) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running rollup_statistician tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing last against a brute-force count, one number a second (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing last with gaps, and beyond the second ring (40 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing advance and late numbers (20 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the rollup_statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
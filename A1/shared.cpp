@@ -0,0 +1,199 @@
+// FILE: shared.cpp
+// brief Implementation of the shared_statistician class.
+
+#include <cassert>      // Provides assert
+#include <cstring>      // Provides memcmp, memcpy
+#include <chrono>       // Provides steady_clock, milliseconds
+#include <new>          // Provides placement new
+#include <thread>       // Provides yield
+#include <fcntl.h>      // Provides O_CREAT, O_EXCL, O_RDWR
+#include <sys/mman.h>   // Provides mmap, munmap, shm_open, shm_unlink
+#include <sys/stat.h>   // Provides fstat
+#include <unistd.h>     // Provides close, ftruncate
+#include "shared.h"
+
+namespace CISP430_A1 {
+
+	namespace {
+		const char MAGIC[8] = {'S', 'H', 'S', 'T', 'A', 'T', 'S', '1'};
+	}
+
+	// The counters are used by several processes, so they must not need a lock.
+	static_assert(std::atomic<unsigned>::is_always_lock_free,
+		"slot counters must be lock-free to work in shared memory");
+
+	// Constructor
+	shared_statistician::shared_statistician() : header(0), table(0), bytes(0) {}
+
+	// Destructor
+	shared_statistician::~shared_statistician() {
+		detach();
+	}
+
+	// Map size bytes of fd (or anonymous memory if fd < 0)
+	bool shared_statistician::map(int fd, size_type size) {
+		int flags = fd < 0 ? MAP_SHARED | MAP_ANONYMOUS : MAP_SHARED;
+		void* address = mmap(0, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+		if (fd >= 0) close(fd);
+		if (address == MAP_FAILED) return false;
+		header = static_cast<segment_header*>(address);
+		table = reinterpret_cast<slot*>(header + 1);
+		bytes = size;
+		return true;
+	}
+
+	// Make a new segment with empty slots
+	bool shared_statistician::create(const char* name, size_type slots) {
+		assert(slots > 0);
+		detach();
+		size_type size = sizeof(segment_header) + slots * sizeof(slot);
+
+		int fd = -1;
+		if (name != 0) {
+			// Never reuse an existing segment: shrinking or clearing one that
+			// another process has mapped would crash it (SIGBUS) or corrupt it.
+			fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (fd < 0) return false;
+			if (ftruncate(fd, off_t(size)) != 0) {
+				close(fd);
+				shm_unlink(name);
+				return false;
+			}
+		}
+		if (!map(fd, size)) {
+			if (name != 0) shm_unlink(name);
+			return false;
+		}
+
+		for (size_type i = 0; i < slots; ++i) {
+			new (&table[i]) slot;
+			table[i].version.store(0, std::memory_order_relaxed);
+		}
+		header->slot_count = slots;
+		header->slot_size = sizeof(slot);
+		// The magic goes in last, so a reader that sees it sees the slots.
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+		return true;
+	}
+
+	// Attach to a segment made by create
+	bool shared_statistician::attach(const char* name) {
+		detach();
+		int fd = shm_open(name, O_RDWR, 0);
+		if (fd < 0) return false;
+		struct stat info;
+		if (fstat(fd, &info) != 0 || size_type(info.st_size) < sizeof(segment_header)) {
+			close(fd);
+			return false;
+		}
+		if (!map(fd, size_type(info.st_size))) return false;
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+			|| header->slot_size != sizeof(slot)
+			|| header->slot_count > (bytes - sizeof(segment_header)) / sizeof(slot)) {
+			detach();
+			return false;
+		}
+		return true;
+	}
+
+	// Unmap the segment
+	void shared_statistician::detach() {
+		if (header != 0) munmap(header, bytes);
+		header = 0;
+		table = 0;
+		bytes = 0;
+	}
+
+	// Remove a named segment
+	bool shared_statistician::remove(const char* name) {
+		return shm_unlink(name) == 0;
+	}
+
+	// Number of slots
+	shared_statistician::size_type shared_statistician::slots() const {
+		assert(attached());
+		return size_type(header->slot_count);
+	}
+
+	// Add a number to a slot (by its only writer)
+	void shared_statistician::next(size_type number, double r) {
+		assert(attached() && number < slots());
+		slot& mine = table[number];
+		unsigned version = mine.version.load(std::memory_order_relaxed);
+		mine.version.store(version + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		mine.stats.next(r);
+		mine.version.store(version + 2, std::memory_order_release);
+	}
+
+	// Clear a slot (by its only writer)
+	void shared_statistician::reset(size_type number) {
+		assert(attached() && number < slots());
+		slot& mine = table[number];
+		unsigned version = mine.version.load(std::memory_order_relaxed);
+		mine.version.store(version + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		mine.stats.reset();
+		mine.version.store(version + 2, std::memory_order_release);
+	}
+
+	// Make a slot whose owner has died consistent again
+	void shared_statistician::recover(size_type number) {
+		assert(attached() && number < slots());
+		slot& dead = table[number];
+		unsigned version = dead.version.load(std::memory_order_relaxed);
+		version = (version | 1) + 1;   // Even, and newer than any copy being read
+		dead.stats.reset();
+		dead.version.store(version, std::memory_order_release);
+	}
+
+	// A consistent copy of one slot (the seqlock read of concurrent.cpp),
+	// giving up if the slot stays odd at the same version for STUCK_MS
+	bool shared_statistician::try_slot_snapshot(size_type number, statistician& copy) const {
+		assert(attached() && number < slots());
+		const slot& s = table[number];
+		statistician attempt;
+		unsigned before, after;
+		unsigned stuck_at = 0;   // The odd version being waited on (0 if none)
+		std::chrono::steady_clock::time_point stuck_since;
+		for (;;) {
+			before = s.version.load(std::memory_order_acquire);
+			if (before & 1) {
+				std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+				if (before != stuck_at) {
+					stuck_at = before;
+					stuck_since = now;
+				}
+				else if (now - stuck_since >= std::chrono::milliseconds(STUCK_MS))
+					return false;
+				std::this_thread::yield();
+				continue;
+			}
+			attempt = s.stats;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			after = s.version.load(std::memory_order_relaxed);
+			if (before == after) break;
+		}
+		copy = attempt;
+		return true;
+	}
+
+	// A consistent copy of one slot, or an empty statistician if it is stuck
+	statistician shared_statistician::slot_snapshot(size_type number) const {
+		statistician copy;
+		try_slot_snapshot(number, copy);
+		return copy;
+	}
+
+	// Merge every slot with + (in slot order), leaving out stuck slots
+	statistician shared_statistician::snapshot() const {
+		statistician result;
+		for (size_type i = 0; i < slots(); ++i)
+			result = result + slot_snapshot(i);
+		return result;
+	}
+
+} // namespace CISP430_A1
@@ -0,0 +1,155 @@
+// FILE: shared.h
+// CLASS PROVIDED: shared_statistician
+//   (a statistician in POSIX shared memory, fed by the worker processes of
+//   a pre-forked server and read by any process that attaches to it)
+//   This class is part of the namespace CISP430_A1.
+//
+//   The segment holds a small header and one slot per worker. Each slot is
+//   on its own cache lines and holds a statistician and a sequence counter,
+//   the same seqlock as concurrent_statistician: the worker that owns a
+//   slot bumps the counter before and after each update with plain stores,
+//   so next is a few memory operations and never a system call, and a
+//   reader copies each slot when its counter is even and unchanged, and
+//   combines the copies with +. The reader never blocks a worker.
+//
+//   Typical use: the parent calls create before forking, so every worker
+//   inherits the mapping and calls next(worker_number, r); an admin
+//   process calls attach with the same name and reads snapshot( ). With a
+//   null name the segment is anonymous and can only be shared by fork.
+//
+// TYPEDEFS for the shared_statistician class:
+//   typedef ____ size_type
+//     shared_statistician::size_type is the data type of slot numbers.
+//
+// CONSTRUCTOR and DESTRUCTOR for the shared_statistician class:
+//   shared_statistician( )
+//     Postcondition: The object is not attached to any segment.
+//   ~shared_statistician( )
+//     Postcondition: The object has been detached (the segment itself
+//     remains until remove is called).
+//
+// PUBLIC MODIFICATION member functions for the shared_statistician class:
+//   bool create(const char* name, size_type slots)
+//     Precondition: slots > 0; name is null or a shared memory name such
+//     as "/myserver-stats".
+//     Postcondition: If the return value is true, a segment with slots
+//     empty slots has been created and the object is attached to it. If
+//     false, the object is not attached; in particular, create fails if a
+//     segment of the same name already exists (other processes may still
+//     be using it). To replace such a segment, call remove first: processes
+//     attached to the old one keep using it until they detach, and never
+//     see it shrink under them.
+//   bool attach(const char* name)
+//     Postcondition: If a segment made by create exists under name, the
+//     object is attached to it and the return value is true. Otherwise the
+//     return value is false and the object is not attached.
+//   void detach( )
+//     Postcondition: The object is not attached.
+//   void next(size_type slot, double r)
+//     Precondition: attached( ), slot < slots( ), and no other thread or
+//     process is giving numbers to the same slot.
+//     Postcondition: The number r has been given to the statistician of
+//     the slot.
+//   void reset(size_type slot)
+//     Precondition: as for next.
+//     Postcondition: The slot has been cleared.
+//   void recover(size_type slot)
+//     Precondition: attached( ), slot < slots( ), and the slot's owner has
+//     died (for example, the parent has seen it exit with waitpid), so no
+//     process is giving numbers to the slot.
+//     Postcondition: The slot has been cleared, and is readable again even
+//     if the owner died in the middle of an update.
+//
+// STATIC member function for the shared_statistician class:
+//   static bool remove(const char* name)
+//     Postcondition: The named segment has been removed (processes that are
+//     attached to it keep it until they detach), and the return value is
+//     true; or there was no such segment and the return value is false.
+//
+// PUBLIC CONSTANT member functions for the shared_statistician class:
+//   bool attached( ) const
+//     Postcondition: The return value is true if the object is attached.
+//   size_type slots( ) const
+//     Precondition: attached( )
+//     Postcondition: The return value is the number of slots.
+//   bool try_slot_snapshot(size_type slot, statistician& copy) const
+//     Precondition: attached( ) and slot < slots( ).
+//     Postcondition: If the return value is true, copy is a consistent copy
+//     of the slot's statistician. It may be called while the slot's owner
+//     is running. The return value is false (and copy is unchanged) if the
+//     slot has been in the middle of the same update for about STUCK_MS
+//     milliseconds, which means that its owner died (or is stopped) there;
+//     the reader waits no longer than that.
+//   statistician slot_snapshot(size_type slot) const
+//     Precondition: attached( ) and slot < slots( ).
+//     Postcondition: The return value is the copy made by try_slot_snapshot,
+//     or an empty statistician if the slot is stuck.
+//   statistician snapshot( ) const
+//     Precondition: attached( )
+//     Postcondition: The return value is the + of every slot, in slot order.
+//     Stuck slots are left out (each one costs the wait described above
+//     until it is recovered).
+//
+// VALUE SEMANTICS for the shared_statistician class:
+// shared_statistician objects may not be copied or assigned.
+//
+// Every process must use a copy of this class built from the same source
+// (the slots hold statistician objects as they are). Programs that use it
+// may have to be linked with -lrt. It is available on POSIX systems only.
+
+#ifndef SHARED_H
+#define SHARED_H
+#include <atomic>    // Provides atomic for the slot sequence counters
+#include <cstdlib>   // Provides size_t
+#include "stats.h"
+
+namespace CISP430_A1
+{
+    class shared_statistician
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        enum { STUCK_MS = 100 };   // How long a reader waits on one update
+        // CONSTRUCTOR and DESTRUCTOR
+        shared_statistician( );
+        ~shared_statistician( );
+        // MODIFICATION MEMBER FUNCTIONS
+        bool create(const char* name, size_type slots);
+        bool attach(const char* name);
+        void detach( );
+        void next(size_type slot, double r);
+        void reset(size_type slot);
+        void recover(size_type slot);
+        // STATIC MEMBER FUNCTION
+        static bool remove(const char* name);
+        // CONSTANT MEMBER FUNCTIONS
+        bool attached( ) const { return header != 0; }
+        size_type slots( ) const;
+        bool try_slot_snapshot(size_type slot, statistician& copy) const;
+        statistician slot_snapshot(size_type slot) const;
+        statistician snapshot( ) const;
+    private:
+        struct alignas(64) segment_header
+        {
+            char magic[8];              // "SHSTATS" and the layout version
+            unsigned long long slot_count;
+            unsigned long long slot_size;
+        };
+        struct alignas(64) slot
+        {
+            std::atomic<unsigned> version;  // Odd while the owner is updating
+            statistician stats;             // The owner's numbers
+        };
+        segment_header* header;  // Start of the mapping, or null
+        slot* table;             // The slots, just after the header
+        size_type bytes;         // Size of the mapping
+        // HELPER MEMBER FUNCTION
+        bool map(int fd, size_type size);
+        // Not copyable
+        shared_statistician(const shared_statistician&);
+        void operator =(const shared_statistician&);
+    };
+}
+
+#endif
@@ -0,0 +1,185 @@
+// FILE: sharedexam.cpp
+
+// This program calls three test functions to test the shared_statistician
+// class with forked worker processes.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>       // Provides steady_clock
+#include <atomic>       // Provides atomic, to play a dead worker
+#include <fcntl.h>      // Provides O_RDWR
+#include <sys/mman.h>   // Provides mmap, shm_open
+#include <sys/wait.h>   // Provides waitpid
+#include <unistd.h>     // Provides fork, getpid, _exit
+#include "shared.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 30, SCORE2 = 40, SCORE3 = 30;
+const char NAME[] = "/sharedexam-stats";
+
+bool close(double a, double b)
+{
+    const double EPSILON = 1e-9;
+    return (fabs(a-b) < EPSILON * (1 + fabs(a)));
+}
+
+// The numbers worker w gives to its slot
+double number(int w, int i)
+{
+    return double((w * 7919 + i * 31) % 2000) - 1000;
+}
+
+int test1( )
+{
+    // create must not reuse a segment that may be in use.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    shared_statistician first, second, reader;
+
+    shared_statistician::remove(NAME);
+    if (!first.create(NAME, 4)) return 0;
+    first.next(2, 5);
+    if (second.create(NAME, 8)) return 0;
+    if (second.attached( )) return 0;
+    if (!reader.attach(NAME)) return 0;
+    if (reader.slots( ) != 4) return 0;
+    if (reader.snapshot( ).length( ) != 1) return 0;
+
+    // After remove, a new segment can be made; the old one lives on for the
+    // objects still attached to it.
+    if (!shared_statistician::remove(NAME)) return 0;
+    if (!second.create(NAME, 8)) return 0;
+    if (second.slots( ) != 8 || second.snapshot( ).length( ) != 0) return 0;
+    first.next(3, 6);
+    if (reader.snapshot( ).length( ) != 2) return 0;
+    shared_statistician::remove(NAME);
+    return SCORE1;
+}
+
+int test2( )
+{
+    // Forked workers each feed their own slot; the snapshot must be the
+    // + of all their numbers.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    const int WORKERS = 4, COUNT = 200000;
+    shared_statistician table;
+    statistician expected;
+
+    if (!table.create(0, WORKERS)) return 0;
+    for (int w = 0; w < WORKERS; ++w)
+    {
+        pid_t child = fork( );
+        if (child < 0) return 0;
+        if (child == 0)
+        {
+            for (int i = 0; i < COUNT; ++i)
+                table.next(w, number(w, i));
+            _exit(0);
+        }
+    }
+
+    // Read while the workers run: every snapshot must be consistent.
+    for (int k = 0; k < 200; ++k)
+    {
+        statistician s = table.snapshot( );
+        if (s.length( ) > 0 && (s.minimum( ) < -1000 || s.maximum( ) > 999)) return 0;
+    }
+    for (int w = 0; w < WORKERS; ++w)
+    {
+        int status;
+        if (wait(&status) < 0 || !WIFEXITED(status)) return 0;
+        for (int i = 0; i < COUNT; ++i)
+            expected.next(number(w, i));
+    }
+
+    statistician s = table.snapshot( );
+    if (s.length( ) != expected.length( )) return 0;
+    if (!close(s.sum( ), expected.sum( ))) return 0;
+    if (s.minimum( ) != expected.minimum( )) return 0;
+    if (s.maximum( ) != expected.maximum( )) return 0;
+    if (!close(s.mean( ), expected.mean( ))) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // A worker that died in the middle of an update must not hang readers.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    shared_statistician table;
+    statistician copy;
+
+    shared_statistician::remove(NAME);
+    if (!table.create(NAME, 3)) return 0;
+    table.next(0, 1);
+    table.next(1, 2);
+    table.next(2, 3);
+
+    // Play the dead worker of slot 1: make its counter odd, as the first
+    // store of an update does, through a separate mapping of the segment.
+    int fd = shm_open(NAME, O_RDWR, 0);
+    if (fd < 0) return 0;
+    void* raw = mmap(0, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (raw == MAP_FAILED) return 0;
+    // The header (64 bytes) records the size of a slot after the magic and
+    // the slot count; each slot starts with its counter.
+    unsigned long long slot_size = static_cast<unsigned long long*>(raw)[2];
+    std::atomic<unsigned>* counter = reinterpret_cast<std::atomic<unsigned>*>(
+        static_cast<char*>(raw) + 64 + slot_size);
+    counter->fetch_add(1);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now( );
+    if (table.try_slot_snapshot(1, copy)) return 0;
+    if (!table.try_slot_snapshot(0, copy) || copy.length( ) != 1) return 0;
+    statistician s = table.snapshot( );
+    if (s.length( ) != 2 || !close(s.sum( ), 4)) return 0;
+    if (std::chrono::steady_clock::now( ) - start > std::chrono::seconds(5)) return 0;
+
+    table.recover(1);
+    if (!table.try_slot_snapshot(1, copy) || copy.length( ) != 0) return 0;
+    table.next(1, 10);
+    if (table.snapshot( ).length( ) != 3) return 0;
+
+    munmap(raw, 4096);
+    shared_statistician::remove(NAME);
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running shared_statistician tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing create, attach and remove (30 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing forked workers against one statistician (40 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing a slot left in the middle of an update (30 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the shared_statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,310 @@
+// FILE: sketches.cpp
+// brief Implementation of the hyperloglog, count_min_sketch and space_saving
+// classes, and of hash_bytes.
+//
+// INVARIANT for the space_saving class:
+//   1. heap[0..used-1] are the counters in use, in min-heap order on count
+//      (so heap[0] has the smallest count), and used <= capacity.
+//   2. index.size( ) is a power of two, at least 2 * capacity. Every counter
+//      heap[i] appears exactly once in index, as the value i + 1, in the
+//      first free slot at or after (wrapping around) the home slot of its
+//      item; all other slots are 0.
+
+#include <algorithm>  // Provides max, min, nth_element, partial_sort, swap
+#include <cassert>    // Provides assert
+#include <cmath>      // Provides log
+#include "sketches.h"
+
+namespace CISP430_A1 {
+
+	namespace {
+
+		// The splitmix64 finalizer: every bit of the result depends on
+		// every bit of x, so consecutive IDs spread over all registers.
+		unsigned long long mix64(unsigned long long x) {
+			x += 0x9E3779B97F4A7C15ULL;
+			x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+			return x ^ (x >> 31);
+		}
+
+		bool larger_count(const space_saving::heavy_hitter& a, const space_saving::heavy_hitter& b) {
+			return a.count > b.count;
+		}
+
+	}
+
+	// FNV-1a over the bytes, then mixed
+	unsigned long long hash_bytes(const void* p, std::size_t n) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(p);
+		unsigned long long h = 0xCBF29CE484222325ULL;
+		for (std::size_t i = 0; i < n; ++i) {
+			h ^= bytes[i];
+			h *= 0x100000001B3ULL;
+		}
+		return mix64(h);
+	}
+
+	// ----------------------------------------------------------------------
+	// hyperloglog
+
+	hyperloglog::hyperloglog(int precision)
+		: precision(precision), registers(std::size_t(1) << precision, 0) {
+		assert(precision >= 4 && precision <= 18);
+	}
+
+	// The top bits pick a register; the register keeps the longest run of
+	// leading zeros (plus one) seen in the remaining bits.
+	void hyperloglog::next(unsigned long long item) {
+		unsigned long long h = mix64(item);
+		std::size_t which = std::size_t(h >> (64 - precision));
+		unsigned long long rest = (h << precision) | (1ULL << (precision - 1));
+		unsigned char rank = (unsigned char)(__builtin_clzll(rest) + 1);
+		if (rank > registers[which])
+			registers[which] = rank;
+	}
+
+	void hyperloglog::reset() {
+		registers.assign(registers.size(), 0);
+	}
+
+	// Flajolet's estimate, with linear counting while registers are empty
+	double hyperloglog::distinct() const {
+		double m = double(registers.size());
+		double harmonic = 0.0;
+		std::size_t zeros = 0;
+		for (std::size_t i = 0; i < registers.size(); ++i) {
+			harmonic += std::ldexp(1.0, -registers[i]);
+			if (registers[i] == 0) ++zeros;
+		}
+
+		double alpha;
+		if (registers.size() == 16) alpha = 0.673;
+		else if (registers.size() == 32) alpha = 0.697;
+		else if (registers.size() == 64) alpha = 0.709;
+		else alpha = 0.7213 / (1.0 + 1.079 / m);
+
+		double estimate = alpha * m * m / harmonic;
+		if (estimate <= 2.5 * m && zeros > 0)
+			estimate = m * std::log(m / double(zeros));
+		return estimate;
+	}
+
+	// Overload the + operator: the larger of each pair of registers
+	hyperloglog operator+(const hyperloglog& h1, const hyperloglog& h2) {
+		assert(h1.precision == h2.precision);
+		hyperloglog result(h1);
+		for (std::size_t i = 0; i < result.registers.size(); ++i)
+			result.registers[i] = std::max(h1.registers[i], h2.registers[i]);
+		return result;
+	}
+
+	// ----------------------------------------------------------------------
+	// count_min_sketch
+
+	count_min_sketch::count_min_sketch(size_type width, size_type depth)
+		: width(width), depth(depth), total(0), table(width * depth, 0) {
+		assert(width > 0 && (width & (width - 1)) == 0);
+		assert(depth >= 1);
+	}
+
+	// Row r uses the column h1 + r * h2 (Kirsch and Mitzenmacher's double
+	// hashing), so one 64-bit mix serves every row.
+	void count_min_sketch::next(unsigned long long item, count_type times) {
+		unsigned long long h = mix64(item);
+		unsigned long long step = (h >> 32) | 1;
+		for (size_type r = 0; r < depth; ++r)
+			table[r * width + size_type((h + r * step) & (width - 1))] += times;
+		total += times;
+	}
+
+	void count_min_sketch::reset() {
+		table.assign(table.size(), 0);
+		total = 0;
+	}
+
+	// The smallest of the item's counters
+	count_min_sketch::count_type count_min_sketch::estimate(unsigned long long item) const {
+		unsigned long long h = mix64(item);
+		unsigned long long step = (h >> 32) | 1;
+		count_type least = table[size_type(h & (width - 1))];
+		for (size_type r = 1; r < depth; ++r)
+			least = std::min(least, table[r * width + size_type((h + r * step) & (width - 1))]);
+		return least;
+	}
+
+	// Overload the + operator: add the tables
+	count_min_sketch operator+(const count_min_sketch& c1, const count_min_sketch& c2) {
+		assert(c1.width == c2.width && c1.depth == c2.depth);
+		count_min_sketch result(c1);
+		for (count_min_sketch::size_type i = 0; i < result.table.size(); ++i)
+			result.table[i] += c2.table[i];
+		result.total += c2.total;
+		return result;
+	}
+
+	// ----------------------------------------------------------------------
+	// space_saving
+
+	space_saving::space_saving(size_type capacity)
+		: capacity(capacity), used(0), total(0), heap(capacity) {
+		assert(capacity >= 1);
+		size_type slots = 2;
+		while (slots < 2 * capacity)
+			slots *= 2;
+		index.assign(slots, 0);
+	}
+
+	// The slot that holds item, or the empty slot where it would go
+	space_saving::size_type space_saving::slot_of(unsigned long long item) const {
+		size_type mask = index.size() - 1;
+		size_type slot = size_type(mix64(item)) & mask;
+		while (index[slot] != 0 && heap[index[slot] - 1].item != item)
+			slot = (slot + 1) & mask;
+		return slot;
+	}
+
+	// Put h at the free heap position i and point its slot there
+	void space_saving::place(size_type i, const heavy_hitter& h) {
+		heap[i] = h;
+		index[slot_of(h.item)] = i + 1;
+	}
+
+	// Exchange the counters at heap positions a and b, and their slots
+	void space_saving::exchange(size_type a, size_type b) {
+		size_type slot_a = slot_of(heap[a].item);
+		size_type slot_b = slot_of(heap[b].item);
+		std::swap(heap[a], heap[b]);
+		index[slot_a] = b + 1;
+		index[slot_b] = a + 1;
+	}
+
+	// Restore the heap order below position i after its count grew
+	void space_saving::sift_down(size_type i) {
+		for (;;) {
+			size_type child = 2 * i + 1;
+			if (child >= used) break;
+			if (child + 1 < used && heap[child + 1].count < heap[child].count) ++child;
+			if (heap[child].count >= heap[i].count) break;
+			exchange(i, child);
+			i = child;
+		}
+	}
+
+	// Remove item from the index, shifting back the items probed after it
+	void space_saving::unindex(unsigned long long item) {
+		size_type mask = index.size() - 1;
+		size_type hole = slot_of(item);
+		index[hole] = 0;
+		for (size_type j = (hole + 1) & mask; index[j] != 0; j = (j + 1) & mask) {
+			size_type home = size_type(mix64(heap[index[j] - 1].item)) & mask;
+			// The entry may move back into the hole unless its home slot
+			// lies (cyclically) after the hole, up to j.
+			bool stays = (hole < j) ? (home > hole && home <= j) : (home > hole || home <= j);
+			if (!stays) {
+				index[hole] = index[j];
+				index[j] = 0;
+				hole = j;
+			}
+		}
+	}
+
+	void space_saving::next(unsigned long long item, count_type times) {
+		total += times;
+		size_type slot = slot_of(item);
+
+		if (index[slot] != 0) {
+			size_type i = index[slot] - 1;
+			heap[i].count += times;
+			sift_down(i);
+		}
+		else if (used < capacity) {
+			// A new counter: sift it up from the bottom of the heap
+			heavy_hitter fresh = { item, times, 0 };
+			size_type i = used++;
+			heap[i] = fresh;
+			index[slot] = i + 1;
+			while (i > 0 && heap[(i - 1) / 2].count > heap[i].count) {
+				exchange(i, (i - 1) / 2);
+				i = (i - 1) / 2;
+			}
+		}
+		else {
+			// Take over the counter with the smallest count
+			heavy_hitter fresh = { item, heap[0].count + times, heap[0].count };
+			unindex(heap[0].item);
+			place(0, fresh);
+			sift_down(0);
+		}
+	}
+
+	void space_saving::reset() {
+		used = 0;
+		total = 0;
+		index.assign(index.size(), 0);
+	}
+
+	// The k largest counters, largest first
+	space_saving::size_type space_saving::top(heavy_hitter* out, size_type k) const {
+		std::vector<heavy_hitter> sorted(heap.begin(), heap.begin() + used);
+		k = std::min(k, used);
+		std::partial_sort(sorted.begin(), sorted.begin() + k, sorted.end(), larger_count);
+		std::copy(sorted.begin(), sorted.begin() + k, out);
+		return k;
+	}
+
+	// An upper bound on the count of item
+	space_saving::count_type space_saving::estimate(unsigned long long item) const {
+		size_type slot = slot_of(item);
+		if (index[slot] != 0) return heap[index[slot] - 1].count;
+		return used == capacity ? heap[0].count : 0;
+	}
+
+	// Overload the + operator: add the counters of matching items, charge an
+	// item missing from one side with that side's smallest count, and keep
+	// the capacity largest
+	space_saving operator+(const space_saving& s1, const space_saving& s2) {
+		assert(s1.capacity == s2.capacity);
+		typedef space_saving::size_type size_type;
+		typedef space_saving::count_type count_type;
+		count_type floor1 = s1.used == s1.capacity ? s1.heap[0].count : 0;
+		count_type floor2 = s2.used == s2.capacity ? s2.heap[0].count : 0;
+
+		std::vector<space_saving::heavy_hitter> merged;
+		merged.reserve(s1.used + s2.used);
+		for (size_type i = 0; i < s1.used; ++i) {
+			space_saving::heavy_hitter h = s1.heap[i];
+			size_type slot = s2.slot_of(h.item);
+			if (s2.index[slot] != 0) {
+				h.count += s2.heap[s2.index[slot] - 1].count;
+				h.error += s2.heap[s2.index[slot] - 1].error;
+			}
+			else {
+				h.count += floor2;
+				h.error += floor2;
+			}
+			merged.push_back(h);
+		}
+		for (size_type i = 0; i < s2.used; ++i) {
+			space_saving::heavy_hitter h = s2.heap[i];
+			if (s1.index[s1.slot_of(h.item)] != 0) continue;
+			h.count += floor1;
+			h.error += floor1;
+			merged.push_back(h);
+		}
+		if (merged.size() > s1.capacity) {
+			std::nth_element(merged.begin(), merged.begin() + s1.capacity, merged.end(), larger_count);
+			merged.resize(s1.capacity);
+		}
+
+		space_saving result(s1.capacity);
+		result.total = s1.total + s2.total;
+		result.used = merged.size();
+		for (size_type i = 0; i < merged.size(); ++i)
+			result.place(i, merged[i]);
+		for (size_type i = result.used / 2; i-- > 0; )
+			result.sift_down(i);
+		return result;
+	}
+
+} // namespace CISP430_A1
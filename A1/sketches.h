@@ -0,0 +1,189 @@
+// FILE: sketches.h
+// CLASSES PROVIDED: hyperloglog, count_min_sketch, space_saving
+//   (fixed-size summaries of a stream of identifiers, such as request IDs
+//   or user IDs: how many distinct ones there are, how often each one
+//   occurs, and which occur most often)
+//   These classes are part of the namespace CISP430_A1.
+//
+//   The identifiers (items) are 64-bit unsigned integers. Other IDs, such
+//   as strings, can be turned into items with hash_bytes. Each class
+//   allocates all of its memory in its constructor, so next never
+//   allocates, and like the statistician each has next, reset and a +
+//   operator that merges two summaries built with the same parameters.
+//
+// FUNCTION for turning byte strings into items:
+//   unsigned long long hash_bytes(const void* p, size_t n)
+//     Postcondition: The return value is a 64-bit hash of the n bytes at p.
+//
+// --------------------------------------------------------------------------
+// CLASS hyperloglog: an estimate of the number of distinct items
+//   2^precision one-byte registers; the standard error of the estimate is
+//   about 1.04 / sqrt(2^precision) (0.8% for the default precision 14,
+//   which uses 16 KB).
+//
+//   hyperloglog(int precision = 14)
+//     Precondition: 4 <= precision <= 18.
+//     Postcondition: The sketch is empty.
+//   void next(unsigned long long item)
+//     Postcondition: The item has been counted.
+//   void reset( )
+//     Postcondition: The sketch has been cleared.
+//   double distinct( ) const
+//     Postcondition: The return value is an estimate of the number of
+//     distinct items counted (small counts are nearly exact).
+//   hyperloglog operator +(const hyperloglog& h1, const hyperloglog& h2)
+//     Precondition: h1 and h2 have the same precision.
+//     Postcondition: The sketch that is returned counts the items of both.
+//
+// --------------------------------------------------------------------------
+// CLASS count_min_sketch: an estimate of how often each item occurs
+//   A depth x width table of counters. estimate(x) is never less than the
+//   true count of x, and with probability 1 - 2^-depth it is more by at
+//   most 2 * length( ) / width.
+//
+//   count_min_sketch(size_type width = 2048, size_type depth = 4)
+//     Precondition: width is a power of two, and depth >= 1.
+//     Postcondition: The sketch is empty.
+//   void next(unsigned long long item, count_type times = 1)
+//     Postcondition: The item has been counted times more times.
+//   void reset( )
+//     Postcondition: The sketch has been cleared.
+//   count_type length( ) const
+//     Postcondition: The return value is the total of all the counts.
+//   count_type estimate(unsigned long long item) const
+//     Postcondition: The return value is an estimate of the item's count.
+//   count_min_sketch operator +(const count_min_sketch& c1,
+//                               const count_min_sketch& c2)
+//     Precondition: c1 and c2 have the same width and depth.
+//     Postcondition: The sketch that is returned counts the items of both.
+//
+// --------------------------------------------------------------------------
+// CLASS space_saving: the most frequent items (Metwally, Agrawal and
+// El Abbadi's Space-Saving algorithm)
+//   capacity counters are kept in a min-heap with a hash index, so next
+//   costs O(log capacity). Any item that occurs more than
+//   length( ) / capacity times is sure to be in the summary, and each
+//   count is too large by at most its error.
+//
+//   struct heavy_hitter { unsigned long long item; count_type count, error; };
+//   space_saving(size_type capacity = 100)
+//     Precondition: capacity >= 1.
+//     Postcondition: The summary is empty.
+//   void next(unsigned long long item, count_type times = 1)
+//     Postcondition: The item has been counted times more times. If it was
+//     not being counted and all counters were in use, it has taken over the
+//     counter with the smallest count.
+//   void reset( )
+//     Postcondition: The summary has been cleared.
+//   count_type length( ) const
+//     Postcondition: The return value is the total of all the counts.
+//   size_type size( ) const
+//     Postcondition: The return value is how many counters are in use.
+//   size_type top(heavy_hitter* out, size_type k) const
+//     Precondition: out points to room for k heavy_hitters.
+//     Postcondition: The min(k, size( )) items with the largest counts
+//     have been written to out, largest first, and the return value is
+//     how many were written.
+//   count_type estimate(unsigned long long item) const
+//     Postcondition: The return value is an upper bound on the item's
+//     count: its counter if it has one, and otherwise the smallest count
+//     (or 0 if not all counters are in use).
+//   space_saving operator +(const space_saving& s1, const space_saving& s2)
+//     Precondition: s1 and s2 have the same capacity.
+//     Postcondition: The summary that is returned covers the items of both
+//     (the merge of Agarwal et al., "Mergeable summaries", 2012: an item
+//     missing from one side is charged that side's smallest count).
+//
+// VALUE SEMANTICS for the three classes:
+// Assignments and the copy constructor may be used with these objects.
+
+#ifndef SKETCHES_H
+#define SKETCHES_H
+#include <cstdlib>   // Provides size_t
+#include <vector>    // Provides vector for the registers, counters and index
+
+namespace CISP430_A1
+{
+    unsigned long long hash_bytes(const void* p, std::size_t n);
+
+    class hyperloglog
+    {
+    public:
+        // CONSTRUCTOR
+        hyperloglog(int precision = 14);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(unsigned long long item);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        double distinct( ) const;
+        // FRIEND FUNCTIONS
+        friend hyperloglog operator +(const hyperloglog& h1, const hyperloglog& h2);
+    private:
+        int precision;                         // log2 of the number of registers
+        std::vector<unsigned char> registers;  // Longest run of zero bits seen, plus one
+    };
+
+    class count_min_sketch
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        typedef unsigned long long count_type;
+        // CONSTRUCTOR
+        count_min_sketch(size_type width = 2048, size_type depth = 4);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(unsigned long long item, count_type times = 1);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        count_type length( ) const { return total; }
+        count_type estimate(unsigned long long item) const;
+        // FRIEND FUNCTIONS
+        friend count_min_sketch operator +
+            (const count_min_sketch& c1, const count_min_sketch& c2);
+    private:
+        size_type width;
+        size_type depth;
+        count_type total;                // Total of all the counts
+        std::vector<count_type> table;   // depth rows of width counters
+    };
+
+    class space_saving
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        typedef unsigned long long count_type;
+        struct heavy_hitter
+        {
+            unsigned long long item;
+            count_type count;   // Upper bound on how often item occurred
+            count_type error;   // How much count may be too large
+        };
+        // CONSTRUCTOR
+        space_saving(size_type capacity = 100);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(unsigned long long item, count_type times = 1);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        count_type length( ) const { return total; }
+        size_type size( ) const { return used; }
+        size_type top(heavy_hitter* out, size_type k) const;
+        count_type estimate(unsigned long long item) const;
+        // FRIEND FUNCTIONS
+        friend space_saving operator +(const space_saving& s1, const space_saving& s2);
+    private:
+        size_type capacity;
+        size_type used;                   // Counters in use (heap[0..used-1])
+        count_type total;                 // Total of all the counts
+        std::vector<heavy_hitter> heap;   // Min-heap on count
+        std::vector<size_type> index;     // Hash slots: heap position + 1, or 0
+        // HELPER MEMBER FUNCTIONS
+        size_type slot_of(unsigned long long item) const;
+        void sift_down(size_type i);
+        void place(size_type i, const heavy_hitter& h);
+        void exchange(size_type a, size_type b);
+        void unindex(unsigned long long item);
+    };
+}
+
+#endif
@@ -0,0 +1,185 @@
+// FILE: sketchexam.cpp
+
+// This program calls three test functions to test the hyperloglog,
+// count_min_sketch and space_saving classes against exact counts.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <map>
+#include <vector>
+#include "sketches.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 30, SCORE2 = 30, SCORE3 = 40;
+
+// A skewed stream of items: item k (k >= 1) turns up about 1/k as often as
+// item 1, so there are a few heavy hitters and a long tail
+vector<unsigned long long> skewed_stream(size_t n, unsigned long long seed)
+{
+    vector<unsigned long long> items;
+    unsigned long long state = seed;
+    for (size_t i = 0; i < n; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double u = double(state >> 11) / 9007199254740992.0;
+        items.push_back((unsigned long long)(exp(u * log(20000.0))));
+    }
+    return items;
+}
+
+int test1( )
+{
+    // hyperloglog: small counts nearly exact, large counts within a few
+    // standard errors, and + the same as one sketch of both streams.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    hyperloglog small, h1, h2, both;
+    unsigned long long i;
+
+    for (i = 0; i < 100; ++i)
+    {
+        small.next(i);
+        small.next(i);
+    }
+    if (fabs(small.distinct( ) - 100) > 2) return 0;
+
+    for (i = 0; i < 200000; ++i)
+    {
+        unsigned long long item = i * 2654435761ULL;
+        if (i < 120000) h1.next(item);
+        if (i >= 80000) h2.next(item);
+        both.next(item);
+    }
+    // Standard error about 0.8%; allow five of them.
+    if (fabs(both.distinct( ) - 200000) > 0.04 * 200000) return 0;
+    if ((h1 + h2).distinct( ) != both.distinct( )) return 0;
+    if ((h2 + h1).distinct( ) != both.distinct( )) return 0;
+
+    both.reset( );
+    if (both.distinct( ) != 0) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // count_min_sketch: never below the true count, rarely far above it,
+    // and + the same as one sketch of both streams.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    count_min_sketch c1(1024, 4), c2(1024, 4), both(1024, 4);
+    vector<unsigned long long> items = skewed_stream(100000, 7);
+    map<unsigned long long, unsigned long long> exact;
+    size_t far = 0;
+
+    for (size_t i = 0; i < items.size( ); ++i)
+    {
+        if (i % 2) c1.next(items[i]);
+        else c2.next(items[i]);
+        both.next(items[i]);
+        ++exact[items[i]];
+    }
+    if (both.length( ) != items.size( )) return 0;
+    if ((c1 + c2).length( ) != items.size( )) return 0;
+
+    count_min_sketch merged = c1 + c2;
+    for (map<unsigned long long, unsigned long long>::iterator it = exact.begin( ); it != exact.end( ); ++it)
+    {
+        unsigned long long estimate = both.estimate(it->first);
+        if (estimate < it->second) return 0;
+        if (estimate > it->second + 2 * items.size( ) / 1024) ++far;
+        if (merged.estimate(it->first) != estimate) return 0;
+    }
+    // Each estimate is that far off with probability at most 1/16.
+    if (far > exact.size( ) / 16) return 0;
+    return SCORE2;
+}
+
+// Does the summary keep its promises about the stream it was given?
+bool keeps_promises(const space_saving& s, const map<unsigned long long, unsigned long long>& exact,
+    unsigned long long length, size_t capacity)
+{
+    vector<space_saving::heavy_hitter> top(capacity);
+    size_t n = s.top(&top[0], capacity);
+    map<unsigned long long, bool> kept;
+
+    if (s.length( ) != length) return false;
+    for (size_t i = 0; i < n; ++i)
+    {
+        map<unsigned long long, unsigned long long>::const_iterator it = exact.find(top[i].item);
+        unsigned long long truth = (it == exact.end( )) ? 0 : it->second;
+        if (top[i].count < truth) return false;
+        if (top[i].count - top[i].error > truth) return false;
+        if (i > 0 && top[i].count > top[i - 1].count) return false;
+        kept[top[i].item] = true;
+    }
+    for (map<unsigned long long, unsigned long long>::const_iterator it = exact.begin( ); it != exact.end( ); ++it)
+    {
+        if (it->second > length / capacity && !kept[it->first]) return false;
+        if (s.estimate(it->first) < it->second) return false;
+    }
+    return true;
+}
+
+int test3( )
+{
+    // space_saving: every item that occurs more than length / capacity
+    // times is kept, and every count is an upper bound within its error,
+    // for one summary and for the + of two.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    const size_t CAPACITY = 50;
+    space_saving s1(CAPACITY), s2(CAPACITY), both(CAPACITY);
+    vector<unsigned long long> items = skewed_stream(100000, 11);
+    map<unsigned long long, unsigned long long> exact;
+
+    for (size_t i = 0; i < items.size( ); ++i)
+    {
+        // The halves see different parts of the stream, with different mixes.
+        if (i < 30000 || items[i] % 3 == 0) s1.next(items[i]);
+        else s2.next(items[i]);
+        both.next(items[i]);
+        ++exact[items[i]];
+    }
+    if (both.size( ) != CAPACITY) return 0;
+    if (!keeps_promises(both, exact, items.size( ), CAPACITY)) return 0;
+    if (!keeps_promises(s1 + s2, exact, items.size( ), CAPACITY)) return 0;
+    if (!keeps_promises(s2 + s1, exact, items.size( ), CAPACITY)) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running sketch tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing hyperloglog (30 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing count_min_sketch (30 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing space_saving (40 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the sketches to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,233 @@
+// FILE: snapexam.cpp
+
+// This program calls three test functions to test the statistician_snapshot
+// class: statisticians saved and restored bit for bit (also through a pipe),
+// snapshots with a damaged header, and snapshots of both kinds of numbers
+// mixed in one stream and combined.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <vector>
+#include <unistd.h>     // Provides pipe, close
+#include "snapshot.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 30, SCORE3 = 30;
+typedef basic_statistician<long long> long_statistician;
+
+// Are a and b the same in every statistic (bit for bit)?
+template <class S>
+bool identical(const S& a, const S& b)
+{
+    if (a.length( ) != b.length( )) return false;
+    if (a.length( ) == 0) return true;
+    return a.sum( ) == b.sum( ) && a.minimum( ) == b.minimum( )
+        && a.maximum( ) == b.maximum( ) && a.mean( ) == b.mean( )
+        && a.variance( ) == b.variance( ) && a.skewness( ) == b.skewness( )
+        && a.kurtosis( ) == b.kurtosis( );
+}
+
+// Some statisticians of each kind: empty, one number, and many
+void make_statisticians(vector<statistician>& doubles, vector<long_statistician>& longs)
+{
+    doubles.assign(4, statistician( ));
+    longs.assign(4, long_statistician( ));
+    doubles[1].next(-2.5);
+    longs[1].next(LLONG_MIN);
+    for (int i = 0; i < 1000; ++i)
+    {
+        doubles[2].next(1e16 * ((i % 2) ? 1 : -1) + i * 0.1);  // The sum has a low part
+        doubles[3].next(i / 3.0 - 100);
+        longs[2].next(LLONG_MAX - i);                           // The sum passes 2^63
+        longs[3].next(i * 7 - 3000);
+    }
+}
+
+int test1( )
+{
+    // Saved and restored statisticians are the same as the originals, also
+    // after a trip through a pipe, and the bytes follow the documented
+    // little-endian layout.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    vector<statistician> doubles;
+    vector<long_statistician> longs;
+    make_statisticians(doubles, longs);
+
+    vector<statistician_snapshot> saved;
+    for (size_t i = 0; i < doubles.size( ); ++i)
+    {
+        saved.push_back(statistician_snapshot(doubles[i]));
+        saved.push_back(statistician_snapshot(longs[i]));
+    }
+
+    int ends[2];
+    if (pipe(ends) != 0) return 0;
+    bool written = write_snapshots(ends[1], saved.data( ), saved.size( ));
+    close(ends[1]);
+    vector<statistician_snapshot> loaded(saved.size( ) + 1);
+    size_t got = read_snapshots(ends[0], loaded.data( ), loaded.size( ));
+    close(ends[0]);
+    if (!written || got != saved.size( )) return 0;
+
+    for (size_t i = 0; i < doubles.size( ); ++i)
+    {
+        statistician d;
+        long_statistician l;
+        if (!loaded[2 * i].valid( ) || loaded[2 * i].numbers( ) != statistician_snapshot::SNAPSHOT_DOUBLE) return 0;
+        if (!loaded[2 * i].restore(d) || !identical(d, doubles[i])) return 0;
+        if (!loaded[2 * i + 1].restore(l) || !identical(l, longs[i])) return 0;
+        if (l.sum( ) != longs[i].sum( )) return 0;
+
+        // Saving the restored statistician again gives the same bytes.
+        if (memcmp(statistician_snapshot(d).data( ), saved[2 * i].data( ), statistician_snapshot::SIZE) != 0) return 0;
+        if (memcmp(statistician_snapshot(l).data( ), saved[2 * i + 1].data( ), statistician_snapshot::SIZE) != 0) return 0;
+    }
+
+    // The layout: magic, version, kind, zero, and the length little-endian
+    const unsigned char* b = saved[5].data( );
+    if (memcmp(b, "STS1", 4) != 0 || b[4] != 1 || b[5] != 0) return 0;
+    if (b[6] != statistician_snapshot::SNAPSHOT_INT64 || b[7] != 0) return 0;
+    if (b[8] != (1000 & 0xff) || b[9] != (1000 >> 8) || b[10] != 0 || b[15] != 0) return 0;
+    if (!statistician_snapshot( ).valid( ) || statistician_snapshot( ).numbers( ) != statistician_snapshot::SNAPSHOT_DOUBLE) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // Any damage to the header makes the snapshot invalid, and restore
+    // then leaves the statistician as it was.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    statistician original;
+    original.next(3);
+    original.next(8);
+    statistician_snapshot good(original);
+
+    // Byte to change, and what to set it to
+    const int DAMAGE[ ][2] = {
+        { 0, 's' }, { 1, 0 }, { 3, '2' },  // The magic
+        { 4, 2 }, { 5, 1 },                // The version
+        { 6, 0 }, { 6, 3 }, { 6, 255 },    // The kind
+        { 7, 1 }, { 7, 0x80 },             // The reserved byte
+        { 15, 0x80 }                       // A negative length
+    };
+
+    for (size_t k = 0; k < sizeof(DAMAGE) / sizeof(DAMAGE[0]); ++k)
+    {
+        statistician_snapshot bad(good);
+        bad.data( )[DAMAGE[k][0]] = (unsigned char)(DAMAGE[k][1]);
+        if (bad.valid( )) return 0;
+
+        statistician s;
+        s.next(-1);
+        long_statistician l;
+        l.next(-1);
+        if (bad.restore(s) || bad.restore(l)) return 0;
+        if (s.length( ) != 1 || s.sum( ) != -1 || l.length( ) != 1 || l.sum( ) != -1) return 0;
+    }
+
+    // A short read gives only whole snapshots.
+    int ends[2];
+    if (pipe(ends) != 0) return 0;
+    bool written = write(ends[1], good.data( ), statistician_snapshot::SIZE - 1)
+        == statistician_snapshot::SIZE - 1;
+    close(ends[1]);
+    statistician_snapshot partial;
+    size_t got = read_snapshots(ends[0], &partial, 1);
+    close(ends[0]);
+    if (!written || got != 0) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // A stream that mixes both kinds: each snapshot restores only into its
+    // own kind, and the restored statisticians, combined with +, equal the
+    // + of the originals of that kind.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    vector<statistician> doubles;
+    vector<long_statistician> longs;
+    make_statisticians(doubles, longs);
+
+    vector<statistician_snapshot> stream;
+    statistician all_doubles;
+    long_statistician all_longs;
+    for (size_t i = 0; i < doubles.size( ); ++i)
+    {
+        stream.push_back(statistician_snapshot(longs[i]));
+        stream.push_back(statistician_snapshot(doubles[i]));
+        all_doubles = all_doubles + doubles[i];
+        all_longs = all_longs + longs[i];
+    }
+
+    statistician merged_doubles;
+    long_statistician merged_longs;
+    size_t as_double = 0, as_long = 0;
+    for (size_t i = 0; i < stream.size( ); ++i)
+    {
+        statistician d;
+        long_statistician l;
+        d.next(42);
+        l.next(42);
+        bool is_double = stream[i].restore(d);
+        bool is_long = stream[i].restore(l);
+        if (is_double == is_long) return 0;   // Exactly one kind fits
+        if (is_double)
+        {
+            if (l.length( ) != 1 || l.sum( ) != 42) return 0;  // Untouched
+            merged_doubles = merged_doubles + d;
+            ++as_double;
+        }
+        else
+        {
+            if (d.length( ) != 1 || d.sum( ) != 42) return 0;
+            merged_longs = merged_longs + l;
+            ++as_long;
+        }
+    }
+    if (as_double != doubles.size( ) || as_long != longs.size( )) return 0;
+    if (!identical(merged_doubles, all_doubles)) return 0;
+    if (!identical(merged_longs, all_longs)) return 0;
+    if (merged_longs.sum( ) != all_longs.sum( )) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running statistician_snapshot tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing saving and restoring, also through a pipe (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing snapshots with a damaged header (30 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing snapshots of both kinds in one stream (30 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the statistician_snapshot to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
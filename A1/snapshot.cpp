@@ -0,0 +1,184 @@
+// FILE: snapshot.cpp
+// brief Implementation of the statistician_snapshot class and of
+// write_snapshots and read_snapshots.
+
+#include <cerrno>      // Provides errno, EINTR
+#include <cstring>     // Provides memcpy, memset
+#include <stdint.h>    // Provides uint16_t, uint64_t
+#include <unistd.h>    // Provides read, write
+#include "snapshot.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SNAPSHOT_BIG_ENDIAN
+#endif
+
+namespace CISP430_A1 {
+
+	namespace {
+
+		// Byte offsets of the fields (see snapshot.h)
+		const std::size_t MAGIC = 0, VERSION_AT = 4, KIND = 6, RESERVED = 7, COUNT = 8,
+			SUM_HIGH = 16, SUM_LOW = 24, TINIEST = 32, LARGEST = 40, CENTER = 48, M2 = 56, M3 = 64, M4 = 72;
+		const char MAGIC_BYTES[4] = {'S', 'T', 'S', '1'};
+
+		// Arrays of snapshots are read and written as one block of bytes.
+		static_assert(sizeof(statistician_snapshot) == statistician_snapshot::SIZE,
+			"a snapshot must have no padding");
+
+		void store64(unsigned char* p, uint64_t bits) {
+#ifdef SNAPSHOT_BIG_ENDIAN
+			bits = __builtin_bswap64(bits);
+#endif
+			std::memcpy(p, &bits, 8);
+		}
+
+		uint64_t load64(const unsigned char* p) {
+			uint64_t bits;
+			std::memcpy(&bits, p, 8);
+#ifdef SNAPSHOT_BIG_ENDIAN
+			bits = __builtin_bswap64(bits);
+#endif
+			return bits;
+		}
+
+		void store_double(unsigned char* p, double x) {
+			uint64_t bits;
+			std::memcpy(&bits, &x, 8);
+			store64(p, bits);
+		}
+
+		double load_double(const unsigned char* p) {
+			uint64_t bits = load64(p);
+			double x;
+			std::memcpy(&x, &bits, 8);
+			return x;
+		}
+
+	}
+
+	// Constructor: an empty statistician
+	statistician_snapshot::statistician_snapshot() {
+		save_common(statistician(), SNAPSHOT_DOUBLE);
+	}
+
+	// Constructor: save a statistician of doubles
+	statistician_snapshot::statistician_snapshot(const statistician& s) {
+		save_common(s, SNAPSHOT_DOUBLE);
+		store_double(bytes + SUM_HIGH, s.total.high());
+		store_double(bytes + SUM_LOW, s.total.low());
+		store_double(bytes + TINIEST, s.tiniest);
+		store_double(bytes + LARGEST, s.largest);
+	}
+
+	// Constructor: save a statistician of 64-bit integers
+	statistician_snapshot::statistician_snapshot(const basic_statistician<long long>& s) {
+		save_common(s, SNAPSHOT_INT64);
+		wide_signed sum = s.total.value();
+		store64(bytes + SUM_HIGH, uint64_t(sum));
+#if defined(__SIZEOF_INT128__)
+		store64(bytes + SUM_LOW, uint64_t(sum >> 64));
+#else
+		store64(bytes + SUM_LOW, sum < 0 ? ~uint64_t(0) : 0);
+#endif
+		store64(bytes + TINIEST, uint64_t(s.tiniest));
+		store64(bytes + LARGEST, uint64_t(s.largest));
+	}
+
+	// Write the header, the length and the moments
+	template <class T, class Acc>
+	void statistician_snapshot::save_common(const basic_statistician<T, Acc>& s, kind k) {
+		std::memset(bytes, 0, SIZE);
+		std::memcpy(bytes + MAGIC, MAGIC_BYTES, 4);
+		bytes[VERSION_AT] = VERSION & 0xff;
+		bytes[VERSION_AT + 1] = VERSION >> 8;
+		bytes[KIND] = (unsigned char)(k);
+		store64(bytes + COUNT, uint64_t(s.count));
+		store_double(bytes + CENTER, s.center);
+		store_double(bytes + M2, s.m2);
+		store_double(bytes + M3, s.m3);
+		store_double(bytes + M4, s.m4);
+	}
+
+	// Read back the length and the moments
+	template <class T, class Acc>
+	void statistician_snapshot::restore_common(basic_statistician<T, Acc>& s) const {
+		s.count = (long long)(load64(bytes + COUNT));
+		s.center = load_double(bytes + CENTER);
+		s.m2 = load_double(bytes + M2);
+		s.m3 = load_double(bytes + M3);
+		s.m4 = load_double(bytes + M4);
+	}
+
+	// Check the header
+	bool statistician_snapshot::valid() const {
+		uint16_t version = uint16_t(bytes[VERSION_AT] | (bytes[VERSION_AT + 1] << 8));
+		return std::memcmp(bytes + MAGIC, MAGIC_BYTES, 4) == 0
+			&& version == VERSION
+			&& (bytes[KIND] == SNAPSHOT_DOUBLE || bytes[KIND] == SNAPSHOT_INT64)
+			&& bytes[RESERVED] == 0
+			&& (long long)(load64(bytes + COUNT)) >= 0;
+	}
+
+	// The kind of numbers saved
+	statistician_snapshot::kind statistician_snapshot::numbers() const {
+		return kind(bytes[KIND]);
+	}
+
+	// Restore a statistician of doubles
+	bool statistician_snapshot::restore(statistician& s) const {
+		if (!valid() || numbers() != SNAPSHOT_DOUBLE) return false;
+		restore_common(s);
+		s.total = compensated_sum<double>(load_double(bytes + SUM_HIGH), load_double(bytes + SUM_LOW));
+		s.tiniest = load_double(bytes + TINIEST);
+		s.largest = load_double(bytes + LARGEST);
+		return true;
+	}
+
+	// Restore a statistician of 64-bit integers
+	bool statistician_snapshot::restore(basic_statistician<long long>& s) const {
+		if (!valid() || numbers() != SNAPSHOT_INT64) return false;
+		restore_common(s);
+#if defined(__SIZEOF_INT128__)
+		wide_unsigned bits = (wide_unsigned(load64(bytes + SUM_LOW)) << 64) | load64(bytes + SUM_HIGH);
+		s.total = exact_sum<long long>(wide_signed(bits));
+#else
+		s.total = exact_sum<long long>(wide_signed(load64(bytes + SUM_HIGH)));
+#endif
+		s.tiniest = (long long)(load64(bytes + TINIEST));
+		s.largest = (long long)(load64(bytes + LARGEST));
+		return true;
+	}
+
+	// Write n snapshots, finishing short writes
+	bool write_snapshots(int fd, const statistician_snapshot* p, std::size_t n) {
+		if (n == 0) return true;
+		const unsigned char* next = p[0].data();
+		std::size_t left = n * statistician_snapshot::SIZE;
+		while (left > 0) {
+			ssize_t done = ::write(fd, next, left);
+			if (done < 0) {
+				if (errno == EINTR) continue;
+				return false;
+			}
+			next += done;
+			left -= std::size_t(done);
+		}
+		return true;
+	}
+
+	// Read up to n whole snapshots
+	std::size_t read_snapshots(int fd, statistician_snapshot* p, std::size_t n) {
+		if (n == 0) return 0;
+		unsigned char* next = p[0].data();
+		std::size_t want = n * statistician_snapshot::SIZE;
+		std::size_t got = 0;
+		while (got < want) {
+			ssize_t done = ::read(fd, next + got, want - got);
+			if (done < 0 && errno == EINTR) continue;
+			if (done <= 0) break;
+			got += std::size_t(done);
+		}
+		return got / statistician_snapshot::SIZE;
+	}
+
+} // namespace CISP430_A1
@@ -0,0 +1,112 @@
+// FILE: snapshot.h
+// CLASS PROVIDED: statistician_snapshot
+//   (a fixed-size binary copy of a statistician, for checkpoints and for
+//   sending statistics from one process to another)
+//   This class is part of the namespace CISP430_A1.
+//
+//   A snapshot is SIZE (80) bytes with no pointers in it, so it may be
+//   written to a pipe or a file, or stored in shared memory, as it is. The
+//   layout is fixed and little-endian on every machine:
+//     bytes  0- 3  the magic "STS1"
+//     bytes  4- 5  the format version (1)
+//     byte   6     the kind of numbers: SNAPSHOT_DOUBLE or SNAPSHOT_INT64
+//     byte   7     zero (reserved for a later version)
+//     bytes  8-15  the length, a 64-bit integer
+//     bytes 16-31  the sum: the two parts of the compensated sum (doubles),
+//                  or the exact 128-bit total (low 64 bits first)
+//     bytes 32-39  the minimum, and bytes 40-47 the maximum
+//     bytes 48-79  the running mean and the central moment sums m2, m3, m4
+//   Every field of the statistician is kept bit for bit, so a restored
+//   statistician is the same as the one that was saved, including the
+//   moments, and restoring is a handful of byte copies: an aggregator can
+//   read snapshots straight into an array and combine them with +.
+//
+//   The quantile sketch and the histogram are not covered: their size
+//   depends on their parameters (and for the sketch, on the data), so they
+//   do not fit a fixed-size record.
+//
+// CONSTANTS for the statistician_snapshot class:
+//   enum { SIZE = 80, VERSION = 1 }
+//   enum kind { SNAPSHOT_DOUBLE = 1, SNAPSHOT_INT64 = 2 }
+//
+// CONSTRUCTORS for the statistician_snapshot class:
+//   statistician_snapshot( )
+//     Postcondition: The snapshot holds an empty statistician.
+//   statistician_snapshot(const statistician& s)
+//   statistician_snapshot(const basic_statistician<long long>& s)
+//     Postcondition: The snapshot holds a copy of s.
+//
+// PUBLIC CONSTANT member functions for the statistician_snapshot class:
+//   bool valid( ) const
+//     Postcondition: The return value is true if the snapshot has the magic
+//     and version written by this class, a known kind of numbers, a zero
+//     reserved byte and a length that is not negative.
+//     (Check this for bytes read from outside the program.)
+//   kind numbers( ) const
+//     Precondition: valid( )
+//     Postcondition: The return value is the kind of numbers saved.
+//   bool restore(statistician& s) const
+//   bool restore(basic_statistician<long long>& s) const
+//     Postcondition: If the snapshot is valid and holds the same kind of
+//     numbers as s, then s has been set to the statistician that was saved
+//     and the return value is true. Otherwise the return value is false and
+//     s is unchanged.
+//   const unsigned char* data( ) const, unsigned char* data( )
+//     Postcondition: The return value points to the SIZE bytes of the
+//     snapshot (to write them, or to read new bytes into them).
+//
+// NON-MEMBER functions:
+//   bool write_snapshots(int fd, const statistician_snapshot* p, size_t n)
+//     Postcondition: The n snapshots p[0..n-1] have been written to the
+//     file descriptor fd, retrying after short writes and interruptions,
+//     and the return value is true; or there was an error and the return
+//     value is false.
+//   size_t read_snapshots(int fd, statistician_snapshot* p, size_t n)
+//     Postcondition: Whole snapshots have been read from fd into p[0],
+//     p[1], ... until n had been read, the end of the file was reached, or
+//     there was an error. The return value is how many were read. (They
+//     are not checked; use valid( ) or restore.)
+//   These two functions are available on POSIX systems only.
+//
+// VALUE SEMANTICS for the statistician_snapshot class:
+// Assignments and the copy constructor may be used with statistician_snapshot
+// objects, and so may memcpy.
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include <cstdlib>   // Provides size_t
+#include "stats.h"
+
+namespace CISP430_A1
+{
+    class statistician_snapshot
+    {
+    public:
+        // CONSTANTS
+        enum { SIZE = 80, VERSION = 1 };
+        enum kind { SNAPSHOT_DOUBLE = 1, SNAPSHOT_INT64 = 2 };
+        // CONSTRUCTORS
+        statistician_snapshot( );
+        statistician_snapshot(const statistician& s);
+        statistician_snapshot(const basic_statistician<long long>& s);
+        // CONSTANT MEMBER FUNCTIONS
+        bool valid( ) const;
+        kind numbers( ) const;
+        bool restore(statistician& s) const;
+        bool restore(basic_statistician<long long>& s) const;
+        const unsigned char* data( ) const { return bytes; }
+        unsigned char* data( ) { return bytes; }
+    private:
+        unsigned char bytes[SIZE];
+        // HELPER MEMBER FUNCTIONS
+        template <class T, class Acc>
+        void save_common(const basic_statistician<T, Acc>& s, kind k);
+        template <class T, class Acc>
+        void restore_common(basic_statistician<T, Acc>& s) const;
+    };
+
+    bool write_snapshots(int fd, const statistician_snapshot* p, std::size_t n);
+    std::size_t read_snapshots(int fd, statistician_snapshot* p, std::size_t n);
+}
+
+#endif
@@ -0,0 +1,185 @@
+// FILE: statbench.cpp
+// A benchmark for the hot paths of the statistician class: next, next_batch,
+// the + operator and the * operator. next and next_batch are timed on
+// several kinds of input (sorted, random, descending so that every number
+// is a new minimum, and cancelling numbers of wildly different sizes that
+// keep the compensated sum's branch guessing), at sizes from one that fits
+// in the L1 cache up to the largest size asked for. Each case is repeated
+// until it has run for a while and the fastest repetition is reported.
+//
+// The results are written to cout as one JSON object, so that runs from
+// different commits can be saved and compared with a script:
+//   {"benchmark": "statbench", "label": ..., "results": [
+//     {"op": "next", "input": "random", "n": 4096, "ns_per_item": 1.23}, ...]}
+// For next and next_batch an item is one number; for + it is one merge of
+// two statisticians, and for * one scaling.
+//
+// Usage: statbench [largest n] [label]
+//   (default largest n is 16777216 numbers, 128 MB; use for example
+//   402653184 for a 3 GB run. The sizes are 4096, 32768, ... up by factors
+//   of 8 while they are below largest n, and then largest n itself. The
+//   label is copied into the output, escaped as a JSON string.)
+
+#include <algorithm>   // Provides sort
+#include <chrono>      // Provides steady_clock
+#include <cstdlib>     // Provides EXIT_SUCCESS, atof
+#include <functional>  // Provides greater
+#include <iostream>    // Provides cout
+#include <random>      // Provides mt19937_64, uniform_real_distribution
+#include <string>
+#include <vector>
+#include "stats.h"
+using namespace CISP430_A1;
+using namespace std;
+
+typedef chrono::steady_clock bench_clock;
+
+double sink = 0.0;    // Results are added here so that no work is skipped
+
+void make_input(const string& kind, vector<double>& data)
+// Postcondition: data has been filled with numbers of the given kind.
+{
+    mt19937_64 engine(430);
+    uniform_real_distribution<double> uniform(0.0, 1000.0);
+    for (size_t i = 0; i < data.size( ); ++i)
+        data[i] = uniform(engine);
+
+    if (kind == "sorted")
+        sort(data.begin( ), data.end( ));
+    else if (kind == "descending")
+        sort(data.begin( ), data.end( ), greater<double>( ));
+    else if (kind == "cancelling")
+    {
+        // Huge numbers of random sign mixed with small ones, so that the
+        // larger of the running total and the next number keeps changing.
+        for (size_t i = 0; i < data.size( ); ++i)
+            if (engine( ) & 1)
+                data[i] = (engine( ) & 2) ? 1e16 : -1e16;
+    }
+}
+
+template <class Work>
+double best_ns(Work work, double items)
+// Postcondition: work( ) has been run repeatedly (at least three times and
+// for at least a quarter of a second), and the return value is the time of
+// the fastest run divided by items, in nanoseconds.
+{
+    double best = 0.0, spent = 0.0;
+    for (int runs = 0; runs < 3 || spent < 0.25; ++runs)
+    {
+        bench_clock::time_point start = bench_clock::now( );
+        work( );
+        double seconds = chrono::duration<double>(bench_clock::now( ) - start).count( );
+        if (runs == 0 || seconds < best)
+            best = seconds;
+        spent += seconds;
+    }
+    return best * 1e9 / items;
+}
+
+string json_string(const string& text)
+// Postcondition: The return value is text as a JSON string literal, with
+// its quotes, backslashes and control characters escaped.
+{
+    const char HEX[ ] = "0123456789abcdef";
+    string quoted = "\"";
+    for (size_t i = 0; i < text.size( ); ++i)
+    {
+        unsigned char c = (unsigned char)(text[i]);
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+            quoted += char(c);
+        }
+        else if (c < 0x20)
+        {
+            quoted += "\\u00";
+            quoted += HEX[c >> 4];
+            quoted += HEX[c & 15];
+        }
+        else
+            quoted += char(c);
+    }
+    return quoted + "\"";
+}
+
+void report(bool& first, const char* op, const string& input, size_t n, double ns)
+// Postcondition: One result object has been written to cout.
+{
+    cout << (first ? "\n" : ",\n")
+         << "    {\"op\": \"" << op << "\", \"input\": \"" << input
+         << "\", \"n\": " << n << ", \"ns_per_item\": " << ns << "}";
+    first = false;
+}
+
+int main(int argc, char* argv[ ])
+{
+    size_t largest = (argc > 1) ? size_t(atof(argv[1])) : size_t(1) << 24;
+    string label = (argc > 2) ? argv[2] : "";
+    const char* kinds[ ] = { "sorted", "random", "descending", "cancelling" };
+
+    cout.precision(4);
+    cout << "{\"benchmark\": \"statbench\", \"label\": " << json_string(label)
+         << ", \"results\": [";
+    bool first = true;
+
+    // next and next_batch: 4K numbers (32 KB, L1) and up by factors of 8,
+    // finishing with largest itself
+    vector<size_t> sizes;
+    for (size_t n = 4096; n < largest; n *= 8)
+        sizes.push_back(n);
+    if (largest > 0)
+        sizes.push_back(largest);
+
+    vector<double> data;
+    for (size_t which = 0; which < sizes.size( ); ++which)
+    {
+        size_t n = sizes[which];
+        data.resize(n);
+        for (size_t k = 0; k < sizeof(kinds) / sizeof(kinds[0]); ++k)
+        {
+            make_input(kinds[k], data);
+            double ns = best_ns([&]( ) {
+                statistician s;
+                for (size_t i = 0; i < n; ++i)
+                    s.next(data[i]);
+                sink += s.sum( );
+            }, double(n));
+            report(first, "next", kinds[k], n, ns);
+
+            ns = best_ns([&]( ) {
+                statistician s;
+                s.next_batch(&data[0], n);
+                sink += s.sum( );
+            }, double(n));
+            report(first, "next_batch", kinds[k], n, ns);
+        }
+    }
+    vector<double>( ).swap(data);
+
+    // + and *: many small statisticians, combined or scaled in turn
+    const size_t PARTS = 4096;
+    vector<statistician> parts(PARTS);
+    for (size_t i = 0; i < PARTS; ++i)
+        for (size_t j = 0; j < 8; ++j)
+            parts[i].next(double(i * 8 + j));
+
+    double ns = best_ns([&]( ) {
+        statistician total;
+        for (size_t i = 0; i < PARTS; ++i)
+            total = total + parts[i];
+        sink += total.sum( );
+    }, double(PARTS));
+    report(first, "operator+", "8 numbers each", PARTS, ns);
+
+    ns = best_ns([&]( ) {
+        double total = 0.0;
+        for (size_t i = 0; i < PARTS; ++i)
+            total += (1.5 * parts[i]).sum( );
+        sink += total;
+    }, double(PARTS));
+    report(first, "operator*", "8 numbers each", PARTS, ns);
+
+    cout << "\n  ], \"checksum\": " << sink << "}" << endl;
+    return EXIT_SUCCESS;
+}
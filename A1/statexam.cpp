@@ -1,253 +1,532 @@
-// FILE: statexam.cpp
-
-// This program calls five test functions to test the statisitician class.
-// Maximum number of points from this program is 200.
-
-#include <iostream>
-#include <cstdlib>
-#include <cmath>
-#include <string.h>    // Provides memcpy function
-#include "stats.h"
-using namespace CISP430_A1;
-using namespace std;
-
-const int SCORE0=0,SCORE1=100, SCORE2=25;
-
-bool close(double a, double b)
-{
-    const double EPSILON = 1e-5;
-    return (fabs(a-b) < EPSILON);
-}
-
-int test1( )
-{
-    // Test program for basic statistician functions.
-    // Returns 90 if everything goes okay; otherwise returns 0.
-
-    statistician s, t;
-    int i;
-    double r = 0;
-
-    if (s.length( ) || t.length( )) return 0;
-    if (s.sum( ) || t.sum( )) return 0;
-
-    for (i = 1; i <= 10000; i++)
-    {
-	s.next(i);
-	r += i;
-    };
-
-    if (t.length( ) || t.sum( )) return 0;
-    if (s.length( ) != 10000) return 0;
-    if (!close(s.sum( ), r)) return 0;
-    if (!close(s.mean( ), r/10000)) return 0;
-    
-    // Reset and then retest everything
-    s.reset( );
-    t.reset( );
-    r = 0;
-    
-    if (s.length( ) || t.length( )) return 0;
-    if (s.sum( ) || t.sum( )) return 0;
-
-    for (i = 1; i <= 10000; i++)
-    {
-	s.next(i);
-	r += i;
-    };
-
-    if (t.length( ) || t.sum( )) return 0;
-    if (s.length( ) != 10000) return 0;
-    if (!close(s.sum( ), r)) return 0;
-    if (!close(s.mean( ), r/10000)) return 0;
-
-    return SCORE1;
-}
-
-int test2( )
-{
-    // Test program for minimum/maximum statistician functions.
-    // Returns 15 if everything goes okay; otherwise returns 0.
-
-    statistician s, t, u;
-    double r = 1000;
-    char n[15] = "10000000000000";
-
-    if (s.length( ) || t.length( )) return 0;
-    if (s.sum( ) || t.sum( )) return 0;
-
-    memcpy(&r, n, sizeof(double));
-    r = 1/r;
-    s.next(r);
-    if ((s.minimum( ) != r) || (s.maximum( ) != r)) return 0;
-    r *= -1;
-    t.next(r);
-    if ((t.minimum( ) != r) || (t.maximum( ) != r)) return 0;
-
-    u.next(100); u.next(-1); u.next(101); u.next(3);
-    if ((u.minimum( ) != -1) || (u.maximum( ) != 101)) return 0;
-
-    return SCORE2;
-}
-
-int test3( )
-{
-    // Test program for + operator of the statistician
-    // Returns 15 if everything goes okay; otherwise returns 0.
-
-    statistician s, t, u, v;
-
-    if (s.length( ) || t.length( )) return 0;
-    if (s.sum( ) || t.sum( )) return 0;
-
-    t.next(5);
-    u.next(0); u.next(10); u.next(10); u.next(20);
-
-    v = s + s;
-    if (v.length( ) || v.sum( )) return 0;
-    v = s + u;
-    if (!(u == v)) return 0;
-    v = t + s;
-    if (!(t == v)) return 0;
-    v = t + u;
-    if (v.length( ) != 5) return 0;
-    if (!close(v.sum( ), 45)) return 0;
-    if (v.minimum( ) != 0) return 0;
-    if (v.maximum( ) != 20) return 0;
-    if (!close(v.mean( ), 45.0/5)) return 0;
-    v = v + t;
-    if (v.length( ) != 6) return 0;
-    if (!close(v.sum( ), 50)) return 0;
-    if (v.minimum( ) != 0) return 0;
-    if (v.maximum( ) != 20) return 0;
-    if (!close(v.mean( ), 50.0/6)) return 0;
-    return SCORE2;
-}
-
-int test4( )
-{
-    // Test program for * operator of the statistician
-    // Returns 15 if everything goes okay; otherwise returns 0.
-
-    statistician s, t, u;
-
-    if (s.length( ) || t.length( )) return 0;
-    if (s.sum( ) || t.sum( )) return 0;
-
-    u.next(0); u.next(10); u.next(10); u.next(20);
-
-    s = 2*u;
-    if (s.length( ) != 4) return 0;
-    if (!close(s.sum( ), 80)) return 0;
-    if (s.minimum( ) != 0) return 0;
-    if (s.maximum( ) != 40) return 0;
-    if (!close(s.mean( ), 80.0/4)) return 0;
-
-    s = -2*u;
-    if (s.length( ) != 4) return 0;
-    if (!close(s.sum( ), -80)) return 0;
-    if (s.minimum( ) != -40) return 0;
-    if (s.maximum( ) != 0) return 0;
-    if (!close(s.mean( ), -80.0/4)) return 0;
-
-    s = 0*u;
-    if (s.length( ) != 4) return 0;
-    if (!close(s.sum( ), 0)) return 0;
-    if (s.minimum( ) != 0) return 0;
-    if (s.maximum( ) != 0) return 0;
-    if (!close(s.mean( ), 0)) return 0;
-
-    s = 10 * t;
-    if (s.length( ) != 0) return 0;
-    if (s.sum( ) != 0) return 0;
-
-    return SCORE2;
-}
-
-int test5( )
-{
-    // Test program for == operator of the statistician.
-    // Returns 15 if everything goes okay; otherwise returns 0.
-
-    statistician s, t, u, v, w, x;
-
-    if (s.length( ) || t.length( )) return 0;
-    if (s.sum( ) || t.sum( )) return 0;
-
-    t.next(10);
-    u.next(0); u.next(10); u.next(10); u.next(20);
-    v.next(5); v.next(0); v.next(20); v.next(15);
-    w.next(0);
-    x.next(0); x.next(0);
-    
-    if (!(s == s)) return 0;
-    if (s == t) return 0;
-    if (t == s) return 0;
-    if (u == t) return 0;
-    if (!(u == v)) return 0;
-    if (w == x) return 0;
-
-    return SCORE2;
-}
-
-int main( )
-{
-    int value = 0;
-    int result;
-    
-    cerr << "Running statistician tests:" << endl;
- 
-    cerr << "TEST 1:" << endl;
-    cerr << "Testing next, reset, length, sum, and mean (100 points).\n";
-    result = test1( );
-    value += result;
-    if (result > 0) cerr << "Test 1 passed." << endl << endl;
-    else cerr << "Test 1 failed." << endl << endl; 
- 
-    cerr << "\nTEST 2:" << endl;
-    cerr << "Testing minimum and maximum member functions (25 points).\n";
-    result = test2( );
-    value += result;
-    if (result > 0) cerr << "Test 2 passed." << endl << endl;
-    else cerr << "Test 2 failed." << endl << endl; 
- 
-    cerr << "\nTEST 3:" << endl;
-    cerr << "Testing the + operator (25 points).\n";
-    result = test3( );
-    value += result;
-    if (result > 0) cerr << "Test 3 passed." << endl << endl;
-    else cerr << "Test 3 failed." << endl << endl; 
- 
-    cerr << "\nTEST 4:" << endl;
-    cerr << "Testing the * operator (25 points).\n";
-    result = test4( );
-    value += result;
-    if (result > 0) cerr << "Test 4 passed." << endl << endl;
-    else cerr << "Test 4 failed." << endl << endl; 
-
-    cerr << "\nTEST 5:" << endl;
-    cerr << "Testing the == operator (25 points).\n";
-    result = test5( );
-    value += result;
-    if (result > 0) cerr << "Test 5 passed." << endl << endl;
-    else cerr << "Test 5 failed." << endl << endl; 
-
-    cerr << "If you submit the statistician to me now, this part of the\n";
-    cerr << "grade will be " << value << " points out of 200.\n";
-	system("PAUSE");
-    
-    return EXIT_SUCCESS;
-
-}
-
-
-
-
-
-
-
-
-
-
-
-
+// FILE: statexam.cpp
+
+// This program calls eight test functions to test the statisitician class.
+// Maximum number of points from this program is 275.
+// (Test 8 uses statistician::from_range, so link with -pthread.)
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <string.h>    // Provides memcpy function
+#include <list>        // Provides list, for an iterator that is not a pointer
+#include <vector>
+#include "stats.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE0=0,SCORE1=100, SCORE2=25;
+
+bool close(double a, double b)
+{
+    const double EPSILON = 1e-5;
+    return (fabs(a-b) < EPSILON);
+}
+
+// Is a within tolerance of b, relative to the size of b?
+bool near(double a, double b, double tolerance)
+{
+    return (fabs(a-b) <= tolerance * (1 + fabs(b)));
+}
+
+// Numbers of mixed signs and sizes for the batch tests
+vector<double> mixed_numbers(size_t n, unsigned long long seed)
+{
+    vector<double> numbers(n);
+    unsigned long long state = seed;
+    for (size_t i = 0; i < n; i++)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double u = double(state >> 11) / 9007199254740992.0;
+        numbers[i] = (u - 0.3) * exp(u * 12);
+    }
+    return numbers;
+}
+
+// Does the batched statistician b agree with the one-at-a-time one?
+bool same_batch(const statistician& a, const statistician& b, double scale)
+{
+    if (a.length( ) != b.length( )) return false;
+    if (a.length( ) == 0) return b.sum( ) == 0;
+    if (!near(b.sum( ), a.sum( ), 1e-12 * scale)) return false;
+    if (isnan(a.minimum( ))) return isnan(b.minimum( )) && isnan(b.maximum( ));
+    return a.minimum( ) == b.minimum( ) && a.maximum( ) == b.maximum( );
+}
+
+// The variance, skewness and kurtosis of p[0..n-1], worked out in two
+// passes (the mean first, then the central moments)
+void two_pass(const double* p, size_t n, double& variance, double& skewness, double& kurtosis)
+{
+    double mean = 0, m2 = 0, m3 = 0, m4 = 0;
+    size_t i;
+    for (i = 0; i < n; i++)
+        mean += p[i];
+    mean /= n;
+    for (i = 0; i < n; i++)
+    {
+        double d = p[i] - mean;
+        m2 += d * d;
+        m3 += d * d * d;
+        m4 += d * d * d * d;
+    }
+    variance = m2 / n;
+    skewness = (m2 == 0) ? 0 : sqrt(double(n)) * m3 / pow(m2, 1.5);
+    kurtosis = (m2 == 0) ? 0 : n * m4 / (m2 * m2) - 3;
+}
+
+// Does s have the moments of p[0..n-1]?
+bool same_moments(const statistician& s, const double* p, size_t n)
+{
+    double variance, skewness, kurtosis;
+    two_pass(p, n, variance, skewness, kurtosis);
+    return s.length( ) == (long long)(n)
+        && near(s.variance( ), variance, 1e-9)
+        && near(s.stddev( ), sqrt(variance), 1e-9)
+        && near(s.skewness( ), skewness, 1e-8)
+        && near(s.kurtosis( ), kurtosis, 1e-8);
+}
+
+int test1( )
+{
+    // Test program for basic statistician functions.
+    // Returns 90 if everything goes okay; otherwise returns 0.
+
+    statistician s, t;
+    int i;
+    double r = 0;
+
+    if (s.length( ) || t.length( )) return 0;
+    if (s.sum( ) || t.sum( )) return 0;
+
+    for (i = 1; i <= 10000; i++)
+    {
+	s.next(i);
+	r += i;
+    };
+
+    if (t.length( ) || t.sum( )) return 0;
+    if (s.length( ) != 10000) return 0;
+    if (!close(s.sum( ), r)) return 0;
+    if (!close(s.mean( ), r/10000)) return 0;
+    
+    // Reset and then retest everything
+    s.reset( );
+    t.reset( );
+    r = 0;
+    
+    if (s.length( ) || t.length( )) return 0;
+    if (s.sum( ) || t.sum( )) return 0;
+
+    for (i = 1; i <= 10000; i++)
+    {
+	s.next(i);
+	r += i;
+    };
+
+    if (t.length( ) || t.sum( )) return 0;
+    if (s.length( ) != 10000) return 0;
+    if (!close(s.sum( ), r)) return 0;
+    if (!close(s.mean( ), r/10000)) return 0;
+
+    return SCORE1;
+}
+
+int test2( )
+{
+    // Test program for minimum/maximum statistician functions.
+    // Returns 15 if everything goes okay; otherwise returns 0.
+
+    statistician s, t, u;
+    double r = 1000;
+    char n[15] = "10000000000000";
+
+    if (s.length( ) || t.length( )) return 0;
+    if (s.sum( ) || t.sum( )) return 0;
+
+    memcpy(&r, n, sizeof(double));
+    r = 1/r;
+    s.next(r);
+    if ((s.minimum( ) != r) || (s.maximum( ) != r)) return 0;
+    r *= -1;
+    t.next(r);
+    if ((t.minimum( ) != r) || (t.maximum( ) != r)) return 0;
+
+    u.next(100); u.next(-1); u.next(101); u.next(3);
+    if ((u.minimum( ) != -1) || (u.maximum( ) != 101)) return 0;
+
+    return SCORE2;
+}
+
+int test3( )
+{
+    // Test program for + operator of the statistician
+    // Returns 15 if everything goes okay; otherwise returns 0.
+
+    statistician s, t, u, v;
+
+    if (s.length( ) || t.length( )) return 0;
+    if (s.sum( ) || t.sum( )) return 0;
+
+    t.next(5);
+    u.next(0); u.next(10); u.next(10); u.next(20);
+
+    v = s + s;
+    if (v.length( ) || v.sum( )) return 0;
+    v = s + u;
+    if (!(u == v)) return 0;
+    v = t + s;
+    if (!(t == v)) return 0;
+    v = t + u;
+    if (v.length( ) != 5) return 0;
+    if (!close(v.sum( ), 45)) return 0;
+    if (v.minimum( ) != 0) return 0;
+    if (v.maximum( ) != 20) return 0;
+    if (!close(v.mean( ), 45.0/5)) return 0;
+    v = v + t;
+    if (v.length( ) != 6) return 0;
+    if (!close(v.sum( ), 50)) return 0;
+    if (v.minimum( ) != 0) return 0;
+    if (v.maximum( ) != 20) return 0;
+    if (!close(v.mean( ), 50.0/6)) return 0;
+    return SCORE2;
+}
+
+int test4( )
+{
+    // Test program for * operator of the statistician
+    // Returns 15 if everything goes okay; otherwise returns 0.
+
+    statistician s, t, u;
+
+    if (s.length( ) || t.length( )) return 0;
+    if (s.sum( ) || t.sum( )) return 0;
+
+    u.next(0); u.next(10); u.next(10); u.next(20);
+
+    s = 2*u;
+    if (s.length( ) != 4) return 0;
+    if (!close(s.sum( ), 80)) return 0;
+    if (s.minimum( ) != 0) return 0;
+    if (s.maximum( ) != 40) return 0;
+    if (!close(s.mean( ), 80.0/4)) return 0;
+
+    s = -2*u;
+    if (s.length( ) != 4) return 0;
+    if (!close(s.sum( ), -80)) return 0;
+    if (s.minimum( ) != -40) return 0;
+    if (s.maximum( ) != 0) return 0;
+    if (!close(s.mean( ), -80.0/4)) return 0;
+
+    s = 0*u;
+    if (s.length( ) != 4) return 0;
+    if (!close(s.sum( ), 0)) return 0;
+    if (s.minimum( ) != 0) return 0;
+    if (s.maximum( ) != 0) return 0;
+    if (!close(s.mean( ), 0)) return 0;
+
+    s = 10 * t;
+    if (s.length( ) != 0) return 0;
+    if (s.sum( ) != 0) return 0;
+
+    return SCORE2;
+}
+
+int test5( )
+{
+    // Test program for == operator of the statistician.
+    // Returns 15 if everything goes okay; otherwise returns 0.
+
+    statistician s, t, u, v, w, x;
+
+    if (s.length( ) || t.length( )) return 0;
+    if (s.sum( ) || t.sum( )) return 0;
+
+    t.next(10);
+    u.next(0); u.next(10); u.next(10); u.next(20);
+    v.next(5); v.next(0); v.next(20); v.next(15);
+    w.next(0);
+    x.next(0); x.next(0);
+    
+    if (!(s == s)) return 0;
+    if (s == t) return 0;
+    if (t == s) return 0;
+    if (u == t) return 0;
+    if (!(u == v)) return 0;
+    if (w == x) return 0;
+
+    return SCORE2;
+}
+
+int test6( )
+{
+    // Test program for next_batch: it must agree with next, one number at
+    // a time, for lengths around the 1024-number chunks and the vector
+    // widths, with and without numbers already given, through a pointer and
+    // through an iterator, and with NaNs in the input.
+    // Returns 25 if everything goes okay; otherwise returns 0.
+
+    const size_t LENGTHS[ ] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1023, 1024, 1025, 2049, 5000 };
+    size_t k, i;
+
+    for (k = 0; k < sizeof(LENGTHS) / sizeof(LENGTHS[0]); k++)
+    {
+        size_t n = LENGTHS[k];
+        vector<double> numbers = mixed_numbers(n, 7 + n);
+        list<double> linked(numbers.begin( ), numbers.end( ));
+        statistician one, batch, iterated, after;
+        double scale = 0;
+
+        for (i = 0; i < n; i++)
+        {
+            one.next(numbers[i]);
+            scale += fabs(numbers[i]);
+        }
+        batch.next_batch(numbers.data( ), n);
+        iterated.next_batch(linked.begin( ), linked.end( ));
+        if (!same_batch(one, batch, scale)) return 0;
+        if (!same_batch(one, iterated, scale)) return 0;
+
+        // With numbers already given (so the first batch number does not
+        // start the minimum and maximum), through vector iterators
+        after.next(-7);
+        after.next(3);
+        after.next_batch(numbers.begin( ), numbers.end( ));
+        statistician before;
+        before.next(-7);
+        before.next(3);
+        for (i = 0; i < n; i++)
+            before.next(numbers[i]);
+        if (!same_batch(before, after, scale + 10)) return 0;
+    }
+
+    // NaNs: one in the middle changes no minimum or maximum; one at the
+    // front is the minimum and maximum for good, as with next.
+    for (k = 0; k < sizeof(LENGTHS) / sizeof(LENGTHS[0]); k++)
+    {
+        size_t n = LENGTHS[k];
+        if (n < 2) continue;
+        vector<double> numbers = mixed_numbers(n, 99 + n);
+        for (size_t where = 0; where < n; where += (n / 3 > 0 ? n / 3 : 1))
+        {
+            vector<double> with_nan(numbers);
+            with_nan[where] = NAN;
+            statistician one, batch;
+            for (i = 0; i < n; i++)
+                one.next(with_nan[i]);
+            batch.next_batch(with_nan.data( ), n);
+            if (one.length( ) != batch.length( )) return 0;
+            if (!isnan(one.sum( )) || !isnan(batch.sum( ))) return 0;
+            if (isnan(one.minimum( )) != isnan(batch.minimum( ))) return 0;
+            if (isnan(one.maximum( )) != isnan(batch.maximum( ))) return 0;
+            if (!isnan(one.minimum( )) && one.minimum( ) != batch.minimum( )) return 0;
+            if (!isnan(one.maximum( )) && one.maximum( ) != batch.maximum( )) return 0;
+        }
+    }
+
+    return SCORE2;
+}
+
+int test7( )
+{
+    // Test program for variance, stddev, skewness and kurtosis: they must
+    // match a two-pass computation after next, next_batch, + and *, and be
+    // zero for a sequence of equal numbers.
+    // Returns 25 if everything goes okay; otherwise returns 0.
+
+    const size_t N = 3000;
+    vector<double> numbers = mixed_numbers(N, 430);
+    statistician one, batch, first, second, third, merged;
+    size_t i;
+
+    for (i = 0; i < N; i++)
+    {
+        numbers[i] += 1e4;   // Far from zero, so a one-pass formula would lose digits
+        one.next(numbers[i]);
+    }
+    batch.next_batch(numbers.data( ), N);
+    if (!same_moments(one, numbers.data( ), N)) return 0;
+    if (!same_moments(batch, numbers.data( ), N)) return 0;
+
+    // + of pieces of very different sizes, given in different ways
+    for (i = 0; i < 7; i++)
+        first.next(numbers[i]);
+    second.next_batch(numbers.data( ) + 7, 1900);
+    for (i = 1907; i < N; i++)
+        third.next(numbers[i]);
+    merged = first + second + third;
+    if (!same_moments(merged, numbers.data( ), N)) return 0;
+    if (!same_moments(third + (second + first), numbers.data( ), N)) return 0;
+    if (!same_moments(statistician( ) + merged, numbers.data( ), N)) return 0;
+
+    // * by positive, negative and zero scales
+    const double SCALES[ ] = { 2.5, -2.5, -1, 0 };
+    for (size_t k = 0; k < sizeof(SCALES) / sizeof(SCALES[0]); k++)
+    {
+        vector<double> scaled(N);
+        for (i = 0; i < N; i++)
+            scaled[i] = SCALES[k] * numbers[i];
+        if (!same_moments(SCALES[k] * one, scaled.data( ), N)) return 0;
+        if (!same_moments(SCALES[k] * merged, scaled.data( ), N)) return 0;
+    }
+
+    // Equal numbers: no spread, and no skewness or kurtosis
+    const double CONSTANTS[ ] = { 0, 0.1, -3.7, 1e10 };
+    for (size_t k = 0; k < sizeof(CONSTANTS) / sizeof(CONSTANTS[0]); k++)
+    {
+        vector<double> same(N, CONSTANTS[k]);
+        statistician a, b;
+        for (i = 0; i < N; i++)
+            a.next(same[i]);
+        b.next_batch(same.data( ), N);
+        statistician c = a + b;
+        statistician d = -2 * b;
+        const statistician* all[ ] = { &a, &b, &c, &d };
+        for (size_t j = 0; j < 4; j++)
+        {
+            if (fabs(all[j]->variance( )) > 1e-20 * (1 + CONSTANTS[k] * CONSTANTS[k])) return 0;
+            if (all[j]->skewness( ) != 0 || all[j]->kurtosis( ) != 0) return 0;
+        }
+    }
+
+    // A single number
+    statistician single;
+    single.next(42);
+    if (single.variance( ) != 0 || single.skewness( ) != 0 || single.kurtosis( ) != 0) return 0;
+
+    return SCORE2;
+}
+
+// Are a and b the same statistician, bit for bit?
+bool identical(const statistician& a, const statistician& b)
+{
+    return a.length( ) == b.length( ) && a.sum( ) == b.sum( )
+        && a.minimum( ) == b.minimum( ) && a.maximum( ) == b.maximum( )
+        && a.variance( ) == b.variance( ) && a.skewness( ) == b.skewness( )
+        && a.kurtosis( ) == b.kurtosis( );
+}
+
+int test8( )
+{
+    // Test program for from_range: at every number of threads it must
+    // agree with a single next_batch over the same range, and the same
+    // number of threads must always give the same answer.
+    // Returns 25 if everything goes okay; otherwise returns 0.
+
+    const size_t N = 1000003;
+    const unsigned THREADS[ ] = { 0, 1, 2, 3, 4, 7, 15, 64 };
+    vector<double> numbers = mixed_numbers(N, 2024);
+    const double* first = numbers.data( );
+    statistician whole;
+    double scale = 0;
+    size_t i;
+
+    whole.next_batch(first, N);
+    for (i = 0; i < N; i++)
+        scale += fabs(numbers[i]);
+
+    for (size_t k = 0; k < sizeof(THREADS) / sizeof(THREADS[0]); k++)
+    {
+        statistician split = statistician::from_range(first, first + N, THREADS[k]);
+        if (split.length( ) != whole.length( )) return 0;
+        if (split.minimum( ) != whole.minimum( ) || split.maximum( ) != whole.maximum( )) return 0;
+        if (!near(split.sum( ), whole.sum( ), 1e-12 * scale)) return 0;
+        if (!near(split.variance( ), whole.variance( ), 1e-9)) return 0;
+        if (!near(split.skewness( ), whole.skewness( ), 1e-8)) return 0;
+        if (!near(split.kurtosis( ), whole.kurtosis( ), 1e-8)) return 0;
+
+        // Run again: the pieces and the order of the merges are fixed
+        for (int again = 0; again < 3; again++)
+            if (!identical(split, statistician::from_range(first, first + N, THREADS[k]))) return 0;
+    }
+
+    // One thread, or a range too short to split, is just next_batch.
+    if (!identical(statistician::from_range(first, first + N, 1), whole)) return 0;
+    statistician short_range;
+    short_range.next_batch(first, 1000);
+    if (!identical(statistician::from_range(first, first + 1000, 8), short_range)) return 0;
+    if (statistician::from_range(first, first, 4).length( ) != 0) return 0;
+
+    return SCORE2;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+    
+    cerr << "Running statistician tests:" << endl;
+ 
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing next, reset, length, sum, and mean (100 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl; 
+ 
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing minimum and maximum member functions (25 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl; 
+ 
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing the + operator (25 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl; 
+ 
+    cerr << "\nTEST 4:" << endl;
+    cerr << "Testing the * operator (25 points).\n";
+    result = test4( );
+    value += result;
+    if (result > 0) cerr << "Test 4 passed." << endl << endl;
+    else cerr << "Test 4 failed." << endl << endl; 
+
+    cerr << "\nTEST 5:" << endl;
+    cerr << "Testing the == operator (25 points).\n";
+    result = test5( );
+    value += result;
+    if (result > 0) cerr << "Test 5 passed." << endl << endl;
+    else cerr << "Test 5 failed." << endl << endl; 
+
+    cerr << "\nTEST 6:" << endl;
+    cerr << "Testing next_batch against next (25 points).\n";
+    result = test6( );
+    value += result;
+    if (result > 0) cerr << "Test 6 passed." << endl << endl;
+    else cerr << "Test 6 failed." << endl << endl; 
+
+    cerr << "\nTEST 7:" << endl;
+    cerr << "Testing variance, stddev, skewness and kurtosis (25 points).\n";
+    result = test7( );
+    value += result;
+    if (result > 0) cerr << "Test 7 passed." << endl << endl;
+    else cerr << "Test 7 failed." << endl << endl; 
+
+    cerr << "\nTEST 8:" << endl;
+    cerr << "Testing from_range (25 points).\n";
+    result = test8( );
+    value += result;
+    if (result > 0) cerr << "Test 8 passed." << endl << endl;
+    else cerr << "Test 8 failed." << endl << endl; 
+
+    cerr << "If you submit the statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 275.\n";
+	system("PAUSE");
+    
+    return EXIT_SUCCESS;
+
+}
+
+
+
+
+
+
+
+
+
+
+
+
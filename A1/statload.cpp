@@ -0,0 +1,137 @@
+// FILE: statload.cpp
+// brief Implementation of load_samples and summarize_samples.
+
+#include <cstring>      // Provides memcpy
+#include <stdint.h>     // Provides int32_t, int64_t, uint32_t, uint64_t
+#include <fcntl.h>      // Provides open
+#include <sys/mman.h>   // Provides mmap, madvise, munmap
+#include <sys/stat.h>   // Provides fstat
+#include <unistd.h>     // Provides close
+#include "statload.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define STATLOAD_BIG_ENDIAN
+#endif
+
+namespace CISP430_A1 {
+
+	namespace {
+
+		// Numbers converted at a time: the size of next_batch's chunks, so
+		// converted numbers are summarized exactly as from_range would.
+		const std::size_t BLOCK = 1024;
+
+		std::size_t sample_size(sample_format format) {
+			return (format == SAMPLE_FLOAT || format == SAMPLE_INT32) ? 4 : 8;
+		}
+
+		uint32_t load32(const unsigned char* p) {
+			uint32_t bits;
+			std::memcpy(&bits, p, 4);
+#ifdef STATLOAD_BIG_ENDIAN
+			bits = __builtin_bswap32(bits);
+#endif
+			return bits;
+		}
+
+		uint64_t load64(const unsigned char* p) {
+			uint64_t bits;
+			std::memcpy(&bits, p, 8);
+#ifdef STATLOAD_BIG_ENDIAN
+			bits = __builtin_bswap64(bits);
+#endif
+			return bits;
+		}
+
+		// Convert n numbers starting at p into out.
+		void decode(const unsigned char* p, std::size_t n, sample_format format, double* out) {
+			switch (format) {
+			case SAMPLE_DOUBLE:
+				for (std::size_t i = 0; i < n; ++i) {
+					uint64_t bits = load64(p + 8 * i);
+					std::memcpy(&out[i], &bits, 8);
+				}
+				break;
+			case SAMPLE_FLOAT:
+				for (std::size_t i = 0; i < n; ++i) {
+					uint32_t bits = load32(p + 4 * i);
+					float value;
+					std::memcpy(&value, &bits, 4);
+					out[i] = value;
+				}
+				break;
+			case SAMPLE_INT32:
+				for (std::size_t i = 0; i < n; ++i)
+					out[i] = double(int32_t(load32(p + 4 * i)));
+				break;
+			case SAMPLE_INT64:
+				for (std::size_t i = 0; i < n; ++i)
+					out[i] = double(int64_t(load64(p + 8 * i)));
+				break;
+			}
+		}
+
+		// Give the n numbers at p to s.
+		void summarize_piece(const unsigned char* p, std::size_t n, sample_format format,
+			statistician& s) {
+#ifndef STATLOAD_BIG_ENDIAN
+			// Aligned native doubles are read in place.
+			if (format == SAMPLE_DOUBLE && reinterpret_cast<uintptr_t>(p) % alignof(double) == 0) {
+				s.next_batch(reinterpret_cast<const double*>(p), n);
+				return;
+			}
+#endif
+			double block[BLOCK];
+			std::size_t size = sample_size(format);
+			for (std::size_t start = 0; start < n; start += BLOCK) {
+				std::size_t k = (n - start < BLOCK) ? n - start : BLOCK;
+				decode(p + start * size, k, format, block);
+				s.next_batch(block, k);
+			}
+		}
+
+	} // unnamed namespace
+
+	// Summarize numbers that are already in memory
+	statistician summarize_samples(const void* data, std::size_t count,
+		sample_format format, unsigned threads) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		std::size_t size = sample_size(format);
+
+		// Split across threads exactly as from_range does, converting each
+		// piece on its own thread.
+		return detail::summarize_pieces<statistician>(count, threads,
+			[bytes, size, format](std::size_t begin, std::size_t end, statistician& part) {
+				summarize_piece(bytes + begin * size, end - begin, format, part);
+			});
+	}
+
+	// Map a file and summarize its numbers
+	bool load_samples(const char* filename, sample_format format,
+		statistician& result, unsigned threads) {
+		int fd = open(filename, O_RDONLY);
+		if (fd < 0) return false;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0) {
+			close(fd);
+			return false;
+		}
+		std::size_t length = std::size_t(info.st_size);
+		if (length == 0) {
+			close(fd);
+			result = statistician();
+			return true;
+		}
+
+		void* map = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);  // The mapping keeps the file open
+		if (map == MAP_FAILED) return false;
+		madvise(map, length, MADV_SEQUENTIAL);
+
+		result = summarize_samples(map, length / sample_size(format), format, threads);
+		munmap(map, length);
+		return true;
+	}
+
+} // namespace CISP430_A1
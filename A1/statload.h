@@ -0,0 +1,55 @@
+// FILE: statload.h
+// FUNCTIONS PROVIDED: load_samples
+//   (summarize a binary file of raw numbers with a statistician, without
+//   reading the file into a buffer)
+//   These functions are part of the namespace CISP430_A1.
+//
+//   The file is mapped into memory with mmap and advised for sequential
+//   access, and the mapped numbers are handed straight to next_batch (little-
+//   endian doubles on a little-endian machine) or converted in small blocks
+//   on the stack (the other formats). With more than one thread the file is
+//   cut into pieces by the same rule as statistician::from_range, so the
+//   result is exactly what from_range gives for the numbers converted to
+//   double, and only depends on the file and the number of threads.
+//
+// TYPES for the load functions:
+//   enum sample_format { SAMPLE_DOUBLE, SAMPLE_FLOAT, SAMPLE_INT32, SAMPLE_INT64 };
+//     The layout of each number in the file: little-endian IEEE double or
+//     float, or little-endian two's complement 32-bit or 64-bit integer.
+//
+// FUNCTIONS:
+//   bool load_samples(const char* filename, sample_format format,
+//                     statistician& result, unsigned threads = 1)
+//     Postcondition: If the file could be opened and mapped, then result
+//     is a statistician that has been given every number in the file, in
+//     order, and the return value is true. (A few bytes at the end that do
+//     not make a whole number are ignored.) Otherwise the return value is
+//     false and result is unchanged. threads == 0 means one thread per
+//     hardware thread.
+//   statistician summarize_samples(const void* data, size_t count,
+//                                  sample_format format, unsigned threads = 1)
+//     Precondition: data points to count numbers in the given format.
+//     Postcondition: The return value is a statistician that has been given
+//     all count numbers, in order (for data already in memory, such as a
+//     shared memory segment).
+//
+// Programs that use these functions must be linked with the thread library
+// (-pthread). They are available on POSIX systems only.
+
+#ifndef STATLOAD_H
+#define STATLOAD_H
+#include <cstdlib>   // Provides size_t
+#include "stats.h"
+
+namespace CISP430_A1
+{
+    enum sample_format { SAMPLE_DOUBLE, SAMPLE_FLOAT, SAMPLE_INT32, SAMPLE_INT64 };
+
+    bool load_samples(const char* filename, sample_format format,
+        statistician& result, unsigned threads = 1);
+
+    statistician summarize_samples(const void* data, std::size_t count,
+        sample_format format, unsigned threads = 1);
+}
+
+#endif
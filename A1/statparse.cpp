@@ -0,0 +1,149 @@
+// FILE: statparse.cpp
+// brief Implementation of scan_text, scan_file and scan_buffer.
+
+#include <cerrno>       // Provides errno, EINTR
+#include <charconv>     // Provides from_chars
+#include <cstring>      // Provides memmove, strcmp
+#include <vector>
+#include <fcntl.h>      // Provides open
+#include <unistd.h>     // Provides read, close
+#include "statparse.h"
+
+namespace CISP430_A1 {
+
+	namespace {
+
+		const std::size_t BUFFER = 1 << 20;  // Bytes read at a time
+		const std::size_t BATCH = 512;       // Numbers given to next_batch at a time
+
+		bool is_separator(char c) {
+			switch (c) {
+			case ' ': case '\n': case '\r': case '\t': case ',': case '\f': case '\v':
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		// Collects numbers and hands them to the statistician in batches.
+		class batcher {
+		public:
+			batcher(statistician& target) : target(target), used(0) {}
+			~batcher() { flush(); }
+			void add(double r) {
+				block[used++] = r;
+				if (used == BATCH) flush();
+			}
+			void flush() {
+				target.next_batch(block, used);
+				used = 0;
+			}
+		private:
+			statistician& target;
+			std::size_t used;
+			double block[BATCH];
+		};
+
+		// Convert every word in [p, end), which must not end in the middle
+		// of a word.
+		void parse_words(const char* p, const char* end, batcher& numbers,
+			unsigned long long& skipped) {
+			while (p < end) {
+				if (is_separator(*p)) {
+					++p;
+					continue;
+				}
+				// from_chars does not accept a leading plus sign, so skip one,
+				// but not when another sign follows it ("+-6" is not a number).
+				const char* start = p;
+				if (*p == '+' && p + 1 < end && p[1] != '+' && p[1] != '-')
+					start = p + 1;
+				double value;
+				std::from_chars_result r = std::from_chars(start, end, value);
+				if (r.ec == std::errc() && (r.ptr == end || is_separator(*r.ptr))) {
+					numbers.add(value);
+					p = r.ptr;
+				}
+				else {
+					++skipped;
+					while (p < end && !is_separator(*p))
+						++p;
+				}
+			}
+		}
+
+	} // unnamed namespace
+
+	// Scan text that is already in memory
+	void scan_buffer(const char* first, const char* last,
+		statistician& result, scan_report& report) {
+		report.bytes = last - first;
+		report.skipped = 0;
+		batcher numbers(result);
+		parse_words(first, last, numbers, report.skipped);
+	}
+
+	// Scan text from a file descriptor, one buffer at a time. The words cut
+	// off at the end of each buffer are moved to its front before the next
+	// read.
+	bool scan_text(int fd, statistician& result, scan_report& report) {
+		std::vector<char> buffer(BUFFER);
+		char* begin = &buffer[0];
+		std::size_t kept = 0;      // Bytes carried over from the last read
+		bool discarding = false;   // In a word too long for the buffer
+
+		report.bytes = 0;
+		report.skipped = 0;
+		batcher numbers(result);
+		for (;;) {
+			ssize_t got = read(fd, begin + kept, BUFFER - kept);
+			if (got < 0) {
+				if (errno == EINTR) continue;
+				return false;
+			}
+			if (got == 0) {
+				parse_words(begin, begin + kept, numbers, report.skipped);
+				return true;
+			}
+			report.bytes += got;
+
+			char* start = begin;
+			char* end = begin + kept + got;
+			if (discarding) {
+				while (start < end && !is_separator(*start))
+					++start;
+				discarding = (start == end);
+				if (discarding) {
+					kept = 0;
+					continue;
+				}
+			}
+			char* cut = end;
+			while (cut > start && !is_separator(cut[-1]))
+				--cut;
+			if (cut == start && end - begin == std::ptrdiff_t(BUFFER)) {
+				// A whole buffer with no separator cannot be a number.
+				++report.skipped;
+				discarding = true;
+				kept = 0;
+				continue;
+			}
+			parse_words(start, cut, numbers, report.skipped);
+			kept = end - cut;
+			std::memmove(begin, cut, kept);
+		}
+	}
+
+	// Scan a named file, or the standard input for "-"
+	bool scan_file(const char* filename, statistician& result, scan_report& report) {
+		if (std::strcmp(filename, "-") == 0)
+			return scan_text(0, result, report);
+
+		int fd = open(filename, O_RDONLY);
+		if (fd < 0) return false;
+		bool ok = scan_text(fd, result, report);
+		close(fd);
+		return ok;
+	}
+
+} // namespace CISP430_A1
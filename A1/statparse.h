@@ -0,0 +1,56 @@
+// FILE: statparse.h
+// FUNCTIONS PROVIDED: scan_text, scan_file
+//   (feed numbers written as decimal text straight into a statistician)
+//   These functions are part of the namespace CISP430_A1.
+//
+//   The text is read in 1 MB blocks with read( ), each number is converted
+//   with std::from_chars, and the numbers are handed to next_batch 512 at a
+//   time, so there is no per-number stream or locale overhead. Numbers may
+//   be separated by any mix of white space and commas. Anything else that
+//   does not convert completely to a double is skipped and counted.
+//
+// TYPES for the scan functions:
+//   struct scan_report
+//   {
+//       unsigned long long bytes;    // How many bytes of text were read
+//       unsigned long long skipped;  // How many words were not numbers
+//   };
+//
+// FUNCTIONS:
+//   bool scan_text(int fd, statistician& result, scan_report& report)
+//     Precondition: fd is a file descriptor open for reading.
+//     Postcondition: Every number in the text read from fd (until end of
+//     file) has been given to result with next_batch, in order, and report
+//     describes the text. The return value is false if a read error stopped
+//     the scan early (the numbers before the error have been given).
+//   bool scan_file(const char* filename, statistician& result, scan_report& report)
+//     Postcondition: As for scan_text, for the named file, or for the
+//     standard input if filename is "-". The return value is false if the
+//     file cannot be opened.
+//   void scan_buffer(const char* first, const char* last,
+//                    statistician& result, scan_report& report)
+//     Postcondition: As for scan_text, for the text in [first, last) (for
+//     text that is already in memory, for example a mapped file).
+//
+// These functions are available on POSIX systems only.
+// statscan.cpp is a command line front end that also reports MB/s.
+
+#ifndef STATPARSE_H
+#define STATPARSE_H
+#include "stats.h"
+
+namespace CISP430_A1
+{
+    struct scan_report
+    {
+        unsigned long long bytes;    // How many bytes of text were read
+        unsigned long long skipped;  // How many words were not numbers
+    };
+
+    bool scan_text(int fd, statistician& result, scan_report& report);
+    bool scan_file(const char* filename, statistician& result, scan_report& report);
+    void scan_buffer(const char* first, const char* last,
+        statistician& result, scan_report& report);
+}
+
+#endif
@@ -1,110 +1,183 @@
-
 // Assignment 1
 
 // FILE: stats.cpp
-// brief Implementation of the statistician class.
+// brief Implementation of the vectorized batch kernel used by
+// statistician::next_batch. The rest of the basic_statistician template
+// class is implemented in stats.template.
 
-#include <cassert>  // Provides assert
-#include <iostream>
-#include <limits> // for numeric limits
+#include <cstdlib>  // Provides size_t
 #include "stats.h"
 
-namespace CISP430_A1 {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATS_X86_KERNELS
+#include <immintrin.h>  // Provides the SSE2 and AVX intrinsics
+#endif
 
-	// Constructor
-	statistician::statistician() : count(0), total(0.0), tiniest(0.0), largest(0.0) {}
+namespace CISP430_A1 {
 
-	// Add a new number to the sequence
-	void statistician::next(double r) {
-		if (count == 0) {
-			tiniest = r;
-			largest = r;
+	namespace {
+
+		// A batch kernel adds p[0..n-1] into the compensated pair (sum,
+		// compensation) and folds them into lo and hi. lo and hi must already
+		// hold a starting value (the current minimum and maximum, or p[0] for
+		// an empty statistician). Comparisons are written as "x < lo" so that
+		// a NaN never replaces a number, just as in next.
+		typedef void (*kernel_function)(const double* p, std::size_t n,
+			double& sum, double& compensation, double& lo, double& hi);
+
+		// One step of Neumaier's compensated summation
+		inline void neumaier(double& sum, double& compensation, double x) {
+			double t = sum + x;
+			if ((sum < 0 ? -sum : sum) >= (x < 0 ? -x : x))
+				compensation += (sum - t) + x;
+			else
+				compensation += (x - t) + sum;
+			sum = t;
 		}
-		else {
-			if (r < tiniest) tiniest = r;
-			if (r > largest) largest = r;
+
+		void scalar_kernel(const double* p, std::size_t n,
+			double& sum, double& compensation, double& lo, double& hi) {
+			double s0 = 0.0, c0 = 0.0, s1 = 0.0, c1 = 0.0;
+			std::size_t i = 0;
+			for (; i + 2 <= n; i += 2) {
+				neumaier(s0, c0, p[i]);
+				neumaier(s1, c1, p[i + 1]);
+				if (p[i] < lo) lo = p[i];
+				if (p[i] > hi) hi = p[i];
+				if (p[i + 1] < lo) lo = p[i + 1];
+				if (p[i + 1] > hi) hi = p[i + 1];
+			}
+			for (; i < n; ++i) {
+				neumaier(s0, c0, p[i]);
+				if (p[i] < lo) lo = p[i];
+				if (p[i] > hi) hi = p[i];
+			}
+			neumaier(sum, compensation, s0);
+			neumaier(sum, compensation, s1);
+			compensation += c0 + c1;
 		}
-		total += r;
-		count++;
-	}
-
-	// Reset the statistician
-	void statistician::reset() {
-		count = 0;
-		total = 0.0;
-		tiniest = 0.0;
-		largest = 0.0;
-	}
-
-	// Calculate the mean of the sequence
-	double statistician::mean() const {
-		assert(count > 0);
-		return total / count;
-	}
-
-	// Return the smallest number in the sequence
-	double statistician::minimum() const {
-		assert(count > 0);
-		return tiniest;
-	}
-
-	// Return the largest number in the sequence
-	double statistician::maximum() const {
-		assert(count > 0);
-		return largest;
-	}
-
-	// Overload the + operator to add two statisticians
-	statistician operator+(const statistician& s1, const statistician& s2) {
-		statistician result;
-
-		result.count = s1.count + s2.count;
-		result.total = s1.total + s2.total;
-
-		if (s1.count == 0) {
-			result.tiniest = s2.tiniest;
-			result.largest = s2.largest;
+
+#ifdef STATS_X86_KERNELS
+		// The vector kernels keep a Neumaier pair per lane: the compensation
+		// takes (s - t) + x where |s| >= |x| and (x - t) + s elsewhere.
+		// _mm_min_pd(x, acc) returns acc when either operand is NaN, which is
+		// exactly the "if (x < acc) acc = x" rule used by next.
+		__attribute__((target("sse2")))
+		inline void sse2_step(__m128d& s, __m128d& c, __m128d x) {
+			const __m128d sign = _mm_set1_pd(-0.0);
+			__m128d t = _mm_add_pd(s, x);
+			__m128d big = _mm_cmpge_pd(_mm_andnot_pd(sign, s), _mm_andnot_pd(sign, x));
+			__m128d a = _mm_add_pd(_mm_sub_pd(s, t), x);
+			__m128d b = _mm_add_pd(_mm_sub_pd(x, t), s);
+			c = _mm_add_pd(c, _mm_or_pd(_mm_and_pd(big, a), _mm_andnot_pd(big, b)));
+			s = t;
 		}
-		else if (s2.count == 0) {
-			result.tiniest = s1.tiniest;
-			result.largest = s1.largest;
+
+		__attribute__((target("sse2")))
+		void sse2_kernel(const double* p, std::size_t n,
+			double& sum, double& compensation, double& lo, double& hi) {
+			__m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+			__m128d c0 = _mm_setzero_pd(), c1 = _mm_setzero_pd();
+			__m128d mn = _mm_set1_pd(lo), mx = _mm_set1_pd(hi);
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				__m128d a = _mm_loadu_pd(p + i);
+				__m128d b = _mm_loadu_pd(p + i + 2);
+				sse2_step(s0, c0, a);
+				sse2_step(s1, c1, b);
+				mn = _mm_min_pd(a, mn);
+				mx = _mm_max_pd(a, mx);
+				mn = _mm_min_pd(b, mn);
+				mx = _mm_max_pd(b, mx);
+			}
+			double sums[4], compensations[4], lows[2], highs[2];
+			_mm_storeu_pd(sums, s0);
+			_mm_storeu_pd(sums + 2, s1);
+			_mm_storeu_pd(compensations, c0);
+			_mm_storeu_pd(compensations + 2, c1);
+			_mm_storeu_pd(lows, mn);
+			_mm_storeu_pd(highs, mx);
+			scalar_kernel(p + i, n - i, sum, compensation, lo, hi);
+			for (int k = 0; k < 4; ++k) {
+				neumaier(sum, compensation, sums[k]);
+				compensation += compensations[k];
+			}
+			for (int k = 0; k < 2; ++k) {
+				if (lows[k] < lo) lo = lows[k];
+				if (highs[k] > hi) hi = highs[k];
+			}
 		}
-		else {
-			result.tiniest = std::min(s1.tiniest, s2.tiniest);
-			result.largest = std::max(s1.largest, s2.largest);
+
+		__attribute__((target("avx")))
+		inline void avx_step(__m256d& s, __m256d& c, __m256d x) {
+			const __m256d sign = _mm256_set1_pd(-0.0);
+			__m256d t = _mm256_add_pd(s, x);
+			__m256d big = _mm256_cmp_pd(_mm256_andnot_pd(sign, s),
+				_mm256_andnot_pd(sign, x), _CMP_GE_OQ);
+			__m256d a = _mm256_add_pd(_mm256_sub_pd(s, t), x);
+			__m256d b = _mm256_add_pd(_mm256_sub_pd(x, t), s);
+			c = _mm256_add_pd(c, _mm256_blendv_pd(b, a, big));
+			s = t;
 		}
 
-		return result;
-	}
-
-	// Overloaded * operator
-	statistician operator*(double scale, const statistician& s) {
-		statistician result;
-		if (s.count > 0) {
-			result.count = s.count;
-			result.total = s.total * scale;
-			if (scale >= 0) {
-				result.tiniest = s.tiniest * scale;
-				result.largest = s.largest * scale;
+		__attribute__((target("avx")))
+		void avx_kernel(const double* p, std::size_t n,
+			double& sum, double& compensation, double& lo, double& hi) {
+			__m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+			__m256d c0 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd();
+			__m256d mn0 = _mm256_set1_pd(lo), mx0 = _mm256_set1_pd(hi);
+			__m256d mn1 = mn0, mx1 = mx0;
+			std::size_t i = 0;
+			for (; i + 8 <= n; i += 8) {
+				__m256d a = _mm256_loadu_pd(p + i);
+				__m256d b = _mm256_loadu_pd(p + i + 4);
+				avx_step(s0, c0, a);
+				avx_step(s1, c1, b);
+				mn0 = _mm256_min_pd(a, mn0);
+				mx0 = _mm256_max_pd(a, mx0);
+				mn1 = _mm256_min_pd(b, mn1);
+				mx1 = _mm256_max_pd(b, mx1);
 			}
-			else {
-				result.tiniest = s.largest * scale;
-				result.largest = s.tiniest * scale;
+			double sums[8], compensations[8], lows[4], highs[4];
+			_mm256_storeu_pd(sums, s0);
+			_mm256_storeu_pd(sums + 4, s1);
+			_mm256_storeu_pd(compensations, c0);
+			_mm256_storeu_pd(compensations + 4, c1);
+			_mm256_storeu_pd(lows, _mm256_min_pd(mn1, mn0));
+			_mm256_storeu_pd(highs, _mm256_max_pd(mx1, mx0));
+			scalar_kernel(p + i, n - i, sum, compensation, lo, hi);
+			for (int k = 0; k < 8; ++k) {
+				neumaier(sum, compensation, sums[k]);
+				compensation += compensations[k];
 			}
+			for (int k = 0; k < 4; ++k) {
+				if (lows[k] < lo) lo = lows[k];
+				if (highs[k] > hi) hi = highs[k];
+			}
+		}
+#endif
+
+		// Choose the widest kernel that this processor supports.
+		kernel_function select_kernel() {
+#ifdef STATS_X86_KERNELS
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx")) return avx_kernel;
+			if (__builtin_cpu_supports("sse2")) return sse2_kernel;
+#endif
+			return scalar_kernel;
 		}
-		return result;
-	}
 
-	// Overloaded == operator
-	bool operator==(const statistician& s1, const statistician& s2) {
-		if (s1.count == 0 && s2.count == 0) {
-			return true;
+	} // unnamed namespace
+
+	namespace detail {
+
+		// Summarize a chunk for statistician::next_batch
+		void batch_kernel(const double* p, std::size_t n,
+			double& sum, double& compensation, double& lo, double& hi) {
+			static const kernel_function kernel = select_kernel();
+			kernel(p, n, sum, compensation, lo, hi);
 		}
-		return s1.count == s2.count &&
-			s1.total == s2.total &&
-			s1.tiniest == s2.tiniest &&
-			s1.largest == s2.largest;
-	}
 
+	} // namespace detail
 
 } // namespace CISP430_A1
@@ -1,8 +1,37 @@
 // FILE: stats.h
-// CLASS PROVIDED: statistician
-//   (a class to keep track of statistics on a sequence of real numbers)
+// TEMPLATE CLASS PROVIDED: basic_statistician<T, Acc>, and its most common
+// instance, statistician (= basic_statistician<double>)
+//   (a class to keep track of statistics on a sequence of numbers)
 //   This class is part of the namespace CISP430_A1.
 //
+// TEMPLATE PARAMETERS:
+//   T is the type of the numbers: any built-in integer or floating point
+//   type. Acc is the accumulator that keeps the sum. The default is chosen
+//   at compile time:
+//     exact_sum<T> for integer T: a 128-bit integer total (where the
+//       compiler has __int128), so sums of 64-bit counters stay exact and
+//       no number is converted to double on the way in;
+//     compensated_sum<T> for floating point T: a Neumaier-compensated
+//       total (kept in double for float), which is accurate to the last
+//       bit or two even for long sequences of numbers with mixed signs and
+//       sizes.
+//   An accumulator provides typedef value_type, a default constructor, and
+//   add(T), merge(const Acc&), scale(T) and value( ) member functions.
+//   (exact_sum can also be built from a total, and compensated_sum from its
+//   two parts high( ) and low( ), of type part_type, which is how
+//   snapshot.h saves them.)
+//   The mean and the moment functions below always work in double.
+//
+// TYPEDEFS for the basic_statistician class:
+//   typedef T value_type
+//   typedef Acc::value_type sum_type
+//     The type returned by sum( ): double for statistician, a 128-bit
+//     integer for the default integer accumulators.
+//
+// In the documentation below, "double" in the type of a number (r, the
+// minimum, the maximum, the scale) stands for T, and the statistician class
+// is basic_statistician<T, Acc>.
+//
 // CONSTRUCTOR for the statistician class:
 //   statistician( );
 //     Postcondition: The object has been initialized, and is ready to accept
@@ -13,16 +42,44 @@
 //   void next(double r)
 //     The number r has been given to the statistician as the next number in
 //     its sequence of numbers.
+//   void next_batch(const double* p, size_t n)
+//     Precondition: p points to an array of at least n numbers.
+//     Postcondition: The n numbers p[0] through p[n-1] have been given to the
+//     statistician, in that order, exactly as if next had been activated for
+//     each of them. The sum is accumulated in several partial sums (one per
+//     vector lane), so it may differ from the one-at-a-time sum in the last
+//     few bits. The minimum and maximum are exact. For statistician, on
+//     x86 processors the work is done by an AVX or SSE2 kernel selected at
+//     run time; other processors and other types use a portable loop.
+//   template <class Iterator> void next_batch(Iterator first, Iterator last)
+//     Postcondition: The numbers in the range [first, last) have been given
+//     to the statistician, as above. The numbers are copied in small blocks
+//     into a local buffer, so any input iterator whose items convert to
+//     double may be used (for a std::span, use s.data( ) and s.size( )).
 //   void reset( );
 //     Postcondition: The statistician has been cleared, as if no numbers had
 //     yet been given to it.
+//
+// STATIC member function for the statistician class:
+//   static statistician from_range(const double* first, const double* last,
+//                                  unsigned threads = 0)
+//     Precondition: [first, last) is a range of numbers in one array.
+//     Postcondition: The return value is a statistician that has been given
+//     every number in the range. The range is cut into equal contiguous
+//     pieces, each piece is summarized by next_batch on its own thread, and
+//     the partial statisticians are combined with + in the order of the
+//     pieces, so the result depends only on the range and the number of
+//     threads. threads == 0 means one thread per hardware thread. Ranges
+//     too short to be worth splitting use fewer threads (at least 64K
+//     numbers per thread). Programs that use this function must be linked
+//     with the thread library (-pthread).
 //   
 // PUBLIC CONSTANT member functions for the statistician class:
-//   int length( ) const
+//   long long length( ) const
 //     Postcondition: The return value is the length of the sequence that has
 //     been given to the statistician (i.e., the number of times that the
 //     next(r) function has been activated).
-//   double sum( ) const
+//   sum_type sum( ) const
 //     Postcondition: The return value is the sum of all the numbers in the
 //     statistician's sequence.
 //   double mean( ) const
@@ -37,6 +94,26 @@
 //     Precondition: length( ) > 0
 //     Postcondition: The return value is the largest number in the
 //     statistician's sequence.
+//   double variance( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the population variance of the
+//     statistician's sequence (the mean squared distance from the mean).
+//   double stddev( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the square root of variance( ).
+//   double skewness( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the population skewness of the
+//     statistician's sequence, or zero if every number is the same.
+//   double kurtosis( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the population excess kurtosis
+//     (zero for a normal distribution) of the statistician's sequence, or
+//     zero if every number is the same.
+//   The four functions above are computed from running central moments
+//   (Welford's method, with Pebay's formulas for merging), so no second
+//   pass over the numbers is needed, and they remain correct for the
+//   results of + and *.
 //
 // NON-MEMBER functions for the statistician class:
 //   statistician operator +(const statistician& s1, const statistician& s2)
@@ -50,47 +127,173 @@
 //     Postcondition: The return value is true if s1 and s2 have the zero
 //     length. Also, if the length is greater than zero, then s1 and s2 must
 //     have the same length, the same  mean, the same minimum, 
-//     the same maximum, and the same sum.
+//     the same maximum, and the same sum. (The variance and the higher
+//     moments are not compared.)
+//   The three operators are defined inside the class (as friends), so the
+//   usual conversions apply to their arguments: 2 * s works for a
+//   statistician even though 2 is an int.
 //     
 // VALUE SEMANTICS for the statistician class:
 // Assignments and the copy constructor may be used with statistician objects.
 
 #ifndef STATS_H     // Prevent duplicate definition
 #define STATS_H
+#include <cstdlib>   // Provides size_t
 #include <iostream>
+#include <type_traits> // Provides is_convertible, is_integral, conditional
 
 namespace CISP430_A1
 {
-    class statistician
+    // Widest integers available for exact sums
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef __int128 wide_signed;
+    __extension__ typedef unsigned __int128 wide_unsigned;
+#else
+    typedef long long wide_signed;
+    typedef unsigned long long wide_unsigned;
+#endif
+
+    // ACCUMULATOR for integer numbers: an exact wide integer total
+    template <class I>
+    class exact_sum
     {
     public:
+        typedef typename std::conditional<std::is_signed<I>::value,
+            wide_signed, wide_unsigned>::type value_type;
+        exact_sum( ) : total(0) { }
+        explicit exact_sum(value_type total) : total(total) { }
+        void add(I x) { total += x; }
+        void merge(const exact_sum& other) { total += other.total; }
+        void scale(I factor) { total *= factor; }
+        value_type value( ) const { return total; }
+    private:
+        value_type total;
+    };
+
+    // ACCUMULATOR for floating point numbers: Neumaier's compensated sum.
+    // The two parts are kept in double when F is narrower (float): in F
+    // itself the compensation, which collects every rounding error, would
+    // itself drift over a long sequence.
+    template <class F>
+    class compensated_sum
+    {
+    public:
+        typedef F value_type;
+        typedef typename std::conditional<(sizeof(F) < sizeof(double)),
+            double, F>::type part_type;
+        compensated_sum( ) : total(0), compensation(0) { }
+        compensated_sum(part_type total, part_type compensation)
+            : total(total), compensation(compensation) { }
+        void add(F x) { add_part(x); }
+        void merge(const compensated_sum& other)
+        {
+            add_part(other.total);
+            compensation += other.compensation;
+        }
+        void scale(F factor) { total *= factor; compensation *= factor; }
+        value_type value( ) const { return F(total + compensation); }
+        // The two parts of the sum, for saving it without rounding
+        part_type high( ) const { return total; }
+        part_type low( ) const { return compensation; }
+    private:
+        part_type total;         // The running sum
+        part_type compensation;  // The low-order bits that total has lost
+        void add_part(part_type x)
+        {
+            part_type t = total + x;
+            if ((total < 0 ? -total : total) >= (x < 0 ? -x : x))
+                compensation += (total - t) + x;
+            else
+                compensation += (x - t) + total;
+            total = t;
+        }
+    };
+
+    // The default accumulator for each type of number
+    template <class T, bool = std::is_integral<T>::value>
+    struct default_accumulator { typedef compensated_sum<T> type; };
+    template <class T>
+    struct default_accumulator<T, true> { typedef exact_sum<T> type; };
+
+    class statistician_snapshot;   // Saves and restores statisticians (snapshot.h)
+
+    template <class T, class Acc = typename default_accumulator<T>::type>
+    class basic_statistician
+    {
+    public:
+        // TYPEDEFS
+        typedef T value_type;
+        typedef typename Acc::value_type sum_type;
         // CONSTRUCTOR
-        statistician( );
+        basic_statistician( );
         // MODIFICATION MEMBER FUNCTIONS
-        void next(double r);
+        void next(T r);
+        void next_batch(const T* p, std::size_t n);
+        template <class Iterator>
+        void next_batch(Iterator first, Iterator last);
         void reset( );
+        // STATIC MEMBER FUNCTION
+        static basic_statistician from_range
+            (const T* first, const T* last, unsigned threads = 0);
         // CONSTANT MEMBER FUNCTIONS
-        int length( ) const { return count; }
-        double sum( ) const { return total; }
+        long long length( ) const { return count; }
+        sum_type sum( ) const { return total.value( ); }
         double mean( ) const;
-        double minimum( ) const;
-        double maximum( ) const;
+        T minimum( ) const;
+        T maximum( ) const;
+        double variance( ) const;
+        double stddev( ) const;
+        double skewness( ) const;
+        double kurtosis( ) const;
         // FRIEND FUNCTIONS
-        friend statistician operator +
-            (const statistician& s1, const statistician& s2);
-        friend statistician operator *
-            (double scale, const statistician& s);
-		friend bool operator ==
-			(const statistician& s1, const statistician& s2); // Add this line
+        friend basic_statistician operator +
+            (const basic_statistician& s1, const basic_statistician& s2)
+            { return plus(s1, s2); }
+        friend basic_statistician operator *
+            (T scale, const basic_statistician& s)
+            { return times(scale, s); }
+        friend bool operator ==
+            (const basic_statistician& s1, const basic_statistician& s2)
+            { return equal(s1, s2); }
+        friend class statistician_snapshot;
     private:
-        int count;       // How many numbers in the sequence
-        double total;    // The sum of all the numbers in the sequence
-        double tiniest;  // The smallest number in the sequence
-        double largest;  // The largest number in the sequence
+        long long count; // How many numbers in the sequence
+        Acc total;       // The sum of all the numbers in the sequence
+        T tiniest;       // The smallest number in the sequence
+        T largest;       // The largest number in the sequence
+        double center;   // The running mean, kept for the moments below
+        double m2;       // Sum of squared distances from center
+        double m3;       // Sum of cubed distances from center
+        double m4;       // Sum of fourth powers of distances from center
+        // HELPER MEMBER FUNCTIONS
+        void merge_moments(double nb, double mean_b, double b2, double b3, double b4);
+        static basic_statistician plus
+            (const basic_statistician& s1, const basic_statistician& s2);
+        static basic_statistician times(T scale, const basic_statistician& s);
+        static bool equal(const basic_statistician& s1, const basic_statistician& s2);
     };
 
-    // NON-MEMBER functions for the statistician class
-    bool operator ==(const statistician& s1, const statistician& s2);
+    // The statistician of the original assignment: numbers of type double
+    typedef basic_statistician<double> statistician;
+
+    namespace detail
+    {
+        // Vectorized sum (with Neumaier compensation), minimum and maximum
+        // of p[0..n-1] for statistician, implemented in stats.cpp. sum and
+        // compensation are added to; lo and hi must hold a starting value.
+        void batch_kernel(const double* p, std::size_t n,
+            double& sum, double& compensation, double& lo, double& hi);
+
+        // The rule from_range uses to spread n numbers over threads: at most
+        // one thread per 64K numbers, equal contiguous pieces, and
+        // piece(begin, end, part) run for each on its own thread to give
+        // numbers begin..end-1 to part. The parts are combined with + in
+        // order. Implemented in stats.template.
+        template <class S, class Piece>
+        S summarize_pieces(std::size_t n, unsigned threads, Piece piece);
+    }
 }
 
+// The implementation of a template class must be included in its header file:
+#include "stats.template"
 #endif
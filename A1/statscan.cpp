@@ -0,0 +1,67 @@
+// FILE: statscan.cpp
+// A command line program that summarizes numbers written as text (one per
+// line, or separated by commas or spaces) with a statistician, and reports
+// how fast the text was read.
+//
+// Usage: statscan [file ...]     (with no files, or "-", reads standard input)
+
+#include <chrono>      // Provides steady_clock
+#include <cstdlib>     // Provides EXIT_SUCCESS, EXIT_FAILURE
+#include <iomanip>     // Provides setw
+#include <iostream>    // Provides cout, cerr
+#include "statparse.h"
+using namespace CISP430_A1;
+using namespace std;
+
+void print_values(const char* name, const statistician& s, const scan_report& report,
+    double seconds);
+// Postcondition: The statistics of s, the number of skipped words, and the
+// rate at which the report.bytes bytes were read have been written to cout.
+
+int main(int argc, char* argv[ ])
+{
+    const char* standard_input[ ] = { "-" };
+    const char* const* files = (argc > 1) ? argv + 1 : standard_input;
+    int count = (argc > 1) ? argc - 1 : 1;
+    int status = EXIT_SUCCESS;
+
+    for (int i = 0; i < count; ++i)
+    {
+        statistician s;
+        scan_report report;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now( );
+        bool ok = scan_file(files[i], s, report);
+        double seconds =
+            chrono::duration<double>(chrono::steady_clock::now( ) - start).count( );
+        if (!ok)
+        {
+            cerr << files[i] << ": could not be read completely." << endl;
+            status = EXIT_FAILURE;
+        }
+        print_values(files[i], s, report, seconds);
+    }
+
+    return status;
+}
+
+void print_values(const char* name, const statistician& s, const scan_report& report,
+    double seconds)
+{
+    cout << name << ':' << endl;
+    cout << setw(10) << "length" << setw(14) << "sum";
+    if (s.length( ) > 0)
+        cout << setw(14) << "minimum" << setw(14) << "mean"
+             << setw(14) << "maximum" << setw(14) << "std dev";
+    cout << endl;
+    cout << setw(10) << s.length( ) << setw(14) << s.sum( );
+    if (s.length( ) > 0)
+        cout << setw(14) << s.minimum( ) << setw(14) << s.mean( )
+             << setw(14) << s.maximum( ) << setw(14) << s.stddev( );
+    cout << endl;
+    cout << "    " << report.bytes << " bytes, " << report.skipped
+         << " words skipped, ";
+    if (seconds > 0)
+        cout << report.bytes / seconds / 1e6 << " MB/s" << endl;
+    else
+        cout << "too fast to time" << endl;
+}
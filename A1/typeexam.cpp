@@ -0,0 +1,216 @@
+// FILE: typeexam.cpp
+
+// This program calls four test functions to test basic_statistician with
+// numbers that are not doubles: long long, unsigned, unsigned long long
+// (all with the exact 128-bit accumulator) and float (with the compensated
+// one).
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <climits>
+#include <vector>
+#include "stats.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 30, SCORE2 = 20, SCORE3 = 20, SCORE4 = 30;
+
+typedef basic_statistician<long long> long_statistician;
+typedef basic_statistician<unsigned> unsigned_statistician;
+typedef basic_statistician<unsigned long long> counter_statistician;
+typedef basic_statistician<float> float_statistician;
+
+bool close(double a, double b)
+{
+    const double EPSILON = 1e-9;
+    return (fabs(a-b) <= EPSILON * (1 + fabs(b)));
+}
+
+int test1( )
+{
+    // long long: sums past 2^63 are exact, next_batch and + agree with
+    // next, and * works with a negative scale.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    long_statistician s, batch, low, high, empty;
+    vector<long long> numbers;
+    wide_signed expected = 0;
+    int i;
+
+    for (i = 0; i < 1000; i++)
+    {
+        long long r = (i % 3 == 0) ? LLONG_MAX - i : (i % 3 == 1) ? i * 1000003LL : -i;
+        numbers.push_back(r);
+        expected += r;
+        s.next(r);
+        if (i < 400) low.next(r);
+        else high.next(r);
+    }
+    batch.next_batch(numbers.data( ), numbers.size( ));
+
+    // The total is about 334 * 2^63, far past what a long long holds.
+    if (s.sum( ) != expected || expected <= wide_signed(LLONG_MAX)) return 0;
+    if (s.length( ) != 1000) return 0;
+    if (s.minimum( ) != -998 || s.maximum( ) != LLONG_MAX) return 0;
+    if (!close(s.mean( ), double(expected) / 1000)) return 0;
+    if (batch.sum( ) != expected || !(batch == s)) return 0;
+    if (!((low + high) == s) || !((high + low) == s) || !((s + empty) == s)) return 0;
+
+    // The negative of a sum past 2^63, and * by -3
+    long_statistician negative = -1 * s;
+    if (negative.sum( ) != -expected) return 0;
+    if (negative.minimum( ) != -LLONG_MAX || negative.maximum( ) != 998) return 0;
+
+    long_statistician small;
+    small.next(-5);
+    small.next(2);
+    small.next(9);
+    long_statistician tripled = -3 * small;
+    if (tripled.sum( ) != -18 || tripled.minimum( ) != -27 || tripled.maximum( ) != 15) return 0;
+    if (!close(tripled.mean( ), -6) || !close(tripled.variance( ), 9 * small.variance( ))) return 0;
+    if (!close(tripled.skewness( ), -small.skewness( ))) return 0;
+    if ((0 * small).sum( ) != 0 || (0 * small).minimum( ) != 0 || (0 * small).variance( ) != 0) return 0;
+    if ((-3 * empty).length( ) != 0) return 0;
+    return SCORE1;
+}
+
+int test2( )
+{
+    // unsigned: sums past what an unsigned holds are exact, and numbers
+    // are never converted to a signed type on the way in.
+    // Returns 20 if everything goes okay; otherwise returns 0.
+
+    unsigned_statistician s, batch, scaled;
+    vector<unsigned> numbers;
+    wide_unsigned expected = 0;
+
+    for (unsigned i = 0; i < 5000; i++)
+    {
+        unsigned r = (i % 2) ? UINT_MAX - i : i;
+        numbers.push_back(r);
+        expected += r;
+        s.next(r);
+    }
+    batch.next_batch(numbers.begin( ), numbers.end( ));
+    if (s.sum( ) != expected || expected <= UINT_MAX) return 0;
+    if (s.minimum( ) != 0 || s.maximum( ) != UINT_MAX - 1) return 0;
+    if (!close(s.mean( ), double(expected) / 5000)) return 0;
+    if (!(batch == s)) return 0;
+
+    // * scales the exact sum in 128 bits.
+    scaled.next(3000000000U);
+    scaled.next(4000000000U);
+    unsigned_statistician big = 4000000000U * scaled;
+    if (big.sum( ) != wide_unsigned(7000000000ULL) * 4000000000U) return 0;
+    if (big.length( ) != 2) return 0;
+    return SCORE2;
+}
+
+int test3( )
+{
+    // unsigned long long: counters whose sum passes 2^64.
+    // Returns 20 if everything goes okay; otherwise returns 0.
+
+    counter_statistician s, t;
+    wide_unsigned expected = 0;
+
+    for (int i = 0; i < 100; i++)
+    {
+        unsigned long long r = ULLONG_MAX - (unsigned long long)(i) * 1000;
+        expected += r;
+        if (i % 2) s.next(r);
+        else t.next(r);
+    }
+    counter_statistician both = s + t;
+    if (both.sum( ) != expected) return 0;
+    if (both.sum( ) / 100 != wide_unsigned(ULLONG_MAX) - 49500) return 0;
+    if (both.minimum( ) != ULLONG_MAX - 99000 || both.maximum( ) != ULLONG_MAX) return 0;
+    if (!close(both.mean( ), double(expected) / 100)) return 0;
+    return SCORE3;
+}
+
+int test4( )
+{
+    // float: the compensated sum keeps a long sum accurate where a plain
+    // float total would drift, and next_batch, + and * agree with next.
+    // Returns 30 if everything goes okay; otherwise returns 0.
+
+    const int N = 1000000;
+    float_statistician s, batch, first, second;
+    vector<float> numbers(N, 0.1f);
+    float plain = 0;
+    int i;
+
+    for (i = 0; i < N; i++)
+    {
+        s.next(numbers[i]);
+        plain += numbers[i];
+        if (i < N / 3) first.next(numbers[i]);
+        else second.next(numbers[i]);
+    }
+    batch.next_batch(numbers.data( ), numbers.size( ));
+
+    // 10^6 times the float nearest 0.1 (about 100000.0015)
+    double exact = double(0.1f) * N;
+    if (fabs(plain - exact) < 100) return 0;   // A plain float total is far off...
+    if (fabs(s.sum( ) - exact) > 0.01) return 0;  // ...the compensated one is not.
+    if (fabs(batch.sum( ) - exact) > 0.01) return 0;
+    if (fabs((first + second).sum( ) - exact) > 0.01) return 0;
+    if (s.minimum( ) != 0.1f || s.maximum( ) != 0.1f) return 0;
+    if (s.variance( ) != 0 || s.skewness( ) != 0) return 0;
+
+    float_statistician mixed;
+    mixed.next(1.5f);
+    mixed.next(-2.0f);
+    mixed.next(4.25f);
+    float_statistician scaled = -2.0f * mixed;
+    if (scaled.sum( ) != -7.5f) return 0;
+    if (scaled.minimum( ) != -8.5f || scaled.maximum( ) != 4.0f) return 0;
+    if (!close(scaled.variance( ), 4 * mixed.variance( ))) return 0;
+    if (!close(scaled.skewness( ), -mixed.skewness( ))) return 0;
+    if (!close(scaled.kurtosis( ), mixed.kurtosis( ))) return 0;
+    return SCORE4;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running basic_statistician tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing basic_statistician<long long> (30 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing basic_statistician<unsigned> (20 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing basic_statistician<unsigned long long> (20 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "\nTEST 4:" << endl;
+    cerr << "Testing basic_statistician<float> (30 points).\n";
+    result = test4( );
+    value += result;
+    if (result > 0) cerr << "Test 4 passed." << endl << endl;
+    else cerr << "Test 4 failed." << endl << endl;
+
+    cerr << "If you submit the basic_statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,108 @@
+// FILE: window.cpp
+// brief Implementation of the window_statistician class.
+
+#include <cassert>   // Provides assert
+#include <cmath>     // Provides fabs
+#include "window.h"
+
+namespace CISP430_A1 {
+
+	// Constructor
+	window_statistician::window_statistician(size_type max_length, double max_age)
+		: max_length(max_length), max_age(max_age), latest(0.0), serial(0),
+		total(0.0), compensation(0.0) {
+		assert(max_length > 0);
+		assert(max_age >= 0);
+	}
+
+	// Add a number with the previous time stamp
+	void window_statistician::next(double r) {
+		next(r, latest);
+	}
+
+	// Add a number stamped with time now
+	void window_statistician::next(double r, double now) {
+		expire(now);
+		if (samples.size() == max_length)
+			evict_oldest();
+
+		sample s = { r, now, serial++ };
+		samples.push_back(s);
+		add_to_total(r);
+
+		// Numbers that can never again be the minimum (or maximum) leave
+		// the back of the queue; each one is removed at most once.
+		while (!lows.empty() && lows.back().value >= r)
+			lows.pop_back();
+		lows.push_back(s);
+		while (!highs.empty() && highs.back().value <= r)
+			highs.pop_back();
+		highs.push_back(s);
+	}
+
+	// Evict numbers that are too old at time now
+	void window_statistician::expire(double now) {
+		assert(now >= latest);
+		latest = now;
+		if (max_age > 0) {
+			while (!samples.empty() && samples.front().stamp <= now - max_age)
+				evict_oldest();
+		}
+	}
+
+	// Reset the window
+	void window_statistician::reset() {
+		latest = 0.0;
+		serial = 0;
+		total = 0.0;
+		compensation = 0.0;
+		samples.clear();
+		lows.clear();
+		highs.clear();
+	}
+
+	// Calculate the mean of the window
+	double window_statistician::mean() const {
+		assert(length() > 0);
+		return sum() / length();
+	}
+
+	// Return the smallest number in the window
+	double window_statistician::minimum() const {
+		assert(length() > 0);
+		return lows.front().value;
+	}
+
+	// Return the largest number in the window
+	double window_statistician::maximum() const {
+		assert(length() > 0);
+		return highs.front().value;
+	}
+
+	// Neumaier's compensated addition, so that adding and later subtracting
+	// the same number leaves no rounding residue behind
+	void window_statistician::add_to_total(double r) {
+		double t = total + r;
+		if (std::fabs(total) >= std::fabs(r))
+			compensation += (total - t) + r;
+		else
+			compensation += (r - t) + total;
+		total = t;
+	}
+
+	// Remove the oldest number from the window and from the queues
+	void window_statistician::evict_oldest() {
+		const sample& oldest = samples.front();
+		add_to_total(-oldest.value);
+		if (lows.front().serial == oldest.serial)
+			lows.pop_front();
+		if (highs.front().serial == oldest.serial)
+			highs.pop_front();
+		samples.pop_front();
+		if (samples.empty()) {
+			total = 0.0;
+			compensation = 0.0;
+		}
+	}
+
+} // namespace CISP430_A1
@@ -0,0 +1,108 @@
+// FILE: window.h
+// CLASS PROVIDED: window_statistician
+//   (a class to keep track of statistics on the most recent numbers of a
+//   sequence, for example the last 1000 numbers or the last 60 seconds)
+//   This class is part of the namespace CISP430_A1.
+//
+//   Older numbers are evicted as new ones arrive. The sum is a running
+//   total (compensated so that evictions do not let rounding errors pile
+//   up), and the minimum and maximum are kept in monotonic queues, so
+//   every operation costs O(1) amortized no matter how large the window is.
+//
+// TYPEDEFS for the window_statistician class:
+//   typedef ____ size_type
+//     window_statistician::size_type is the data type of any variable that
+//     keeps track of how many numbers are in the window.
+//
+// CONSTRUCTOR for the window_statistician class:
+//   window_statistician(size_type max_length, double max_age = 0)
+//     Precondition: max_length > 0 and max_age >= 0.
+//     Postcondition: The window is empty. It will hold at most max_length
+//     numbers, and if max_age > 0, only numbers whose time stamp is more
+//     than now - max_age (see next and expire below).
+//
+// PUBLIC MODIFICATION member functions for the window_statistician class:
+//   void next(double r)
+//     Postcondition: The number r has been added to the window, with the
+//     same time stamp as the previous number. If the window already held
+//     max_length numbers, the oldest one has been evicted.
+//   void next(double r, double now)
+//     Precondition: now >= 0, and now is not less than the time stamp of
+//     any earlier call.
+//     Postcondition: The number r, stamped with time now, has been added to
+//     the window. Numbers too old for max_age, and the oldest number if
+//     max_length is exceeded, have been evicted.
+//   void expire(double now)
+//     Precondition: as for next(r, now).
+//     Postcondition: Numbers too old for max_age at time now have been
+//     evicted (for a window that has not received numbers for a while).
+//   void reset( )
+//     Postcondition: The window has been cleared.
+//
+// PUBLIC CONSTANT member functions for the window_statistician class:
+//   size_type length( ) const
+//     Postcondition: The return value is how many numbers are in the window.
+//   double sum( ) const
+//     Postcondition: The return value is the sum of the numbers in the window.
+//   double mean( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the mean of the numbers in the window.
+//   double minimum( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the smallest number in the window.
+//   double maximum( ) const
+//     Precondition: length( ) > 0
+//     Postcondition: The return value is the largest number in the window.
+//
+// VALUE SEMANTICS for the window_statistician class:
+// Assignments and the copy constructor may be used with window_statistician
+// objects.
+
+#ifndef WINDOW_H
+#define WINDOW_H
+#include <cstdlib>   // Provides size_t
+#include <deque>     // Provides deque for the window and the monotonic queues
+
+namespace CISP430_A1
+{
+    class window_statistician
+    {
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        // CONSTRUCTOR
+        window_statistician(size_type max_length, double max_age = 0);
+        // MODIFICATION MEMBER FUNCTIONS
+        void next(double r);
+        void next(double r, double now);
+        void expire(double now);
+        void reset( );
+        // CONSTANT MEMBER FUNCTIONS
+        size_type length( ) const { return samples.size( ); }
+        double sum( ) const { return total + compensation; }
+        double mean( ) const;
+        double minimum( ) const;
+        double maximum( ) const;
+    private:
+        struct sample
+        {
+            double value;     // The number itself
+            double stamp;     // The time it was given to the window
+            size_type serial; // Its position in the whole sequence
+        };
+        size_type max_length;      // The most numbers the window may hold
+        double max_age;            // Numbers older than this are evicted (0: never)
+        double latest;             // Time stamp of the most recent number
+        size_type serial;          // Serial number for the next number
+        double total;              // Running sum of the window
+        double compensation;       // Low-order bits lost from total
+        std::deque<sample> samples;  // The window, oldest first
+        std::deque<sample> lows;     // Increasing values; front is the minimum
+        std::deque<sample> highs;    // Decreasing values; front is the maximum
+        // HELPER MEMBER FUNCTIONS
+        void add_to_total(double r);
+        void evict_oldest( );
+    };
+}
+
+#endif
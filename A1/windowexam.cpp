@@ -0,0 +1,218 @@
+// FILE: windowexam.cpp
+
+// This program calls three test functions to test the window_statistician
+// class against a brute force computation over every window: numbers kept
+// by count, numbers kept by age, and the running sum after huge numbers
+// have left the window.
+// Maximum number of points from this program is 100.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include "window.h"
+using namespace CISP430_A1;
+using namespace std;
+
+const int SCORE1 = 40, SCORE2 = 40, SCORE3 = 20;
+
+bool close(double a, double b)
+{
+    const double EPSILON = 1e-12;
+    return (fabs(a-b) <= EPSILON * (1 + fabs(b)));
+}
+
+// Does w hold exactly the numbers data[first] through data[last-1]?
+// The minimum, maximum and mean are computed again from scratch.
+bool same_window(const window_statistician& w, const vector<double>& data,
+                 size_t first, size_t last)
+{
+    if (w.length( ) != last - first) return false;
+    if (first == last) return true;
+    double lo = data[first], hi = data[first], total = 0;
+    for (size_t i = first; i < last; ++i)
+    {
+        if (data[i] < lo) lo = data[i];
+        if (data[i] > hi) hi = data[i];
+        total += data[i];
+    }
+    if (w.minimum( ) != lo || w.maximum( ) != hi) return false;
+    return close(w.mean( ), total / (last - first));
+}
+
+// Numbers with long ascending and descending runs, plateaus of ties,
+// a sawtooth and a stretch of pseudorandom numbers
+vector<double> runs( )
+{
+    vector<double> data;
+    unsigned long long state = 430;
+    int i;
+
+    for (i = 0; i < 300; ++i) data.push_back(i);              // Ascending
+    for (i = 300; i > -300; --i) data.push_back(i);           // Descending
+    for (i = 0; i < 100; ++i) data.push_back(7);              // All ties
+    for (i = 0; i < 400; ++i) data.push_back(i % 37);         // Sawtooth up
+    for (i = 0; i < 400; ++i) data.push_back(-(i % 23));      // Sawtooth down
+    for (i = 0; i < 100; ++i) data.push_back((i % 2) ? 5 : -5);  // Alternating
+    for (i = 0; i < 1000; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        data.push_back(double(state >> 40) / 1000 - 8000);
+    }
+    return data;
+}
+
+int test1( )
+{
+    // Windows of several lengths slide over the runs; after every number
+    // the minimum, maximum and mean must match the last max_length numbers.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    const size_t LENGTHS[ ] = { 1, 2, 3, 16, 100, 299, 301, 5000 };
+    vector<double> data = runs( );
+
+    for (size_t k = 0; k < sizeof(LENGTHS) / sizeof(LENGTHS[0]); ++k)
+    {
+        size_t n = LENGTHS[k];
+        window_statistician w(n);
+        if (w.length( ) != 0) return 0;
+        for (size_t i = 0; i < data.size( ); ++i)
+        {
+            w.next(data[i]);
+            size_t first = (i + 1 > n) ? i + 1 - n : 0;
+            if (!same_window(w, data, first, i + 1)) return 0;
+        }
+
+        // A copy slides on by itself, and reset starts over.
+        window_statistician copy(w);
+        copy.next(1e9);
+        if (w.maximum( ) == 1e9 || copy.maximum( ) != 1e9) return 0;
+        w.reset( );
+        if (w.length( ) != 0 || w.sum( ) != 0) return 0;
+        for (size_t i = 0; i < 600; ++i)
+        {
+            w.next(data[i]);
+            size_t first = (i + 1 > n) ? i + 1 - n : 0;
+            if (!same_window(w, data, first, i + 1)) return 0;
+        }
+    }
+    return SCORE1;
+}
+
+int test2( )
+{
+    // The same runs with time stamps (several numbers may share one), kept
+    // for max_age and at most max_length numbers. expire alone must evict
+    // old numbers too.
+    // Returns 40 if everything goes okay; otherwise returns 0.
+
+    const double AGES[ ] = { 0.5, 1, 10, 37.5 };
+    const size_t LENGTHS[ ] = { 4, 50, 100000 };
+    vector<double> data = runs( );
+    vector<double> stamps;
+
+    for (size_t i = 0; i < data.size( ); ++i)
+        stamps.push_back(double(i / 3) + ((i / 3 % 5 == 0) ? 0.25 : 0));
+
+    for (size_t a = 0; a < sizeof(AGES) / sizeof(AGES[0]); ++a)
+    {
+        for (size_t k = 0; k < sizeof(LENGTHS) / sizeof(LENGTHS[0]); ++k)
+        {
+            double age = AGES[a];
+            size_t n = LENGTHS[k];
+            window_statistician w(n, age);
+            size_t first = 0;
+            for (size_t i = 0; i < data.size( ); ++i)
+            {
+                w.next(data[i], stamps[i]);
+                // The window is the numbers stamped after stamps[i] - age,
+                // and of those only the last n.
+                while (stamps[first] <= stamps[i] - age) ++first;
+                if (i + 1 - first > n) first = i + 1 - n;
+                if (!same_window(w, data, first, i + 1)) return 0;
+            }
+
+            // With no new numbers, time moves on until the window is empty.
+            double now = stamps.back( );
+            size_t last = data.size( );
+            while (w.length( ) > 0)
+            {
+                now += age / 4;
+                w.expire(now);
+                while (first < last && stamps[first] <= now - age) ++first;
+                if (!same_window(w, data, first, last)) return 0;
+            }
+            w.next(3, now);
+            if (w.length( ) != 1 || w.minimum( ) != 3 || w.maximum( ) != 3) return 0;
+        }
+    }
+    return SCORE2;
+}
+
+int test3( )
+{
+    // Once huge numbers have left the window, the sum of the small whole
+    // numbers still in it must be exact, not a rounding residue.
+    // Returns 20 if everything goes okay; otherwise returns 0.
+
+    window_statistician w(4);
+    vector<double> data;
+    for (int i = 0; i < 1000; ++i)
+        data.push_back((i % 10 < 4) ? ((i % 2) ? 1e17 : -3e16) : double(i % 10));
+
+    for (size_t i = 0; i < data.size( ); ++i)
+    {
+        w.next(data[i]);
+        if (i % 10 == 9)
+        {
+            // The window is now 6, 7, 8, 9.
+            if (w.sum( ) != 30 || w.mean( ) != 7.5) return 0;
+            if (!same_window(w, data, i - 3, i + 1)) return 0;
+        }
+    }
+
+    // Evicting everything by age leaves an exact zero.
+    window_statistician timed(1000, 1);
+    timed.next(1e300, 0);
+    timed.next(-1e-300, 0);
+    timed.next(1, 0.5);
+    timed.expire(1.25);
+    if (timed.length( ) != 1 || timed.sum( ) != 1) return 0;
+    timed.expire(2);
+    if (timed.length( ) != 0 || timed.sum( ) != 0) return 0;
+    return SCORE3;
+}
+
+int main( )
+{
+    int value = 0;
+    int result;
+
+    cerr << "Running window_statistician tests:" << endl;
+
+    cerr << "TEST 1:" << endl;
+    cerr << "Testing windows of a fixed length against brute force (40 points).\n";
+    result = test1( );
+    value += result;
+    if (result > 0) cerr << "Test 1 passed." << endl << endl;
+    else cerr << "Test 1 failed." << endl << endl;
+
+    cerr << "\nTEST 2:" << endl;
+    cerr << "Testing windows of a fixed age against brute force (40 points).\n";
+    result = test2( );
+    value += result;
+    if (result > 0) cerr << "Test 2 passed." << endl << endl;
+    else cerr << "Test 2 failed." << endl << endl;
+
+    cerr << "\nTEST 3:" << endl;
+    cerr << "Testing the sum after huge numbers are evicted (20 points).\n";
+    result = test3( );
+    value += result;
+    if (result > 0) cerr << "Test 3 passed." << endl << endl;
+    else cerr << "Test 3 failed." << endl << endl;
+
+    cerr << "If you submit the window_statistician to me now, this part of the\n";
+    cerr << "grade will be " << value << " points out of 100.\n";
+
+    return (value == 100) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
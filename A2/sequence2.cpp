@@ -1,32 +1,231 @@
 
 // FILE: sequence2.cpp
 // (This file implements the sequence class as declared in sequence2.h.
-//  It uses a dynamic array that grows as needed (by at least 10% increments)
+//  It keeps short sequences in a buffer inside the object, and longer ones in a
+//  dynamic array that grows as needed (by the sequence's growth policy)
 //  and provides proper copy control including a copy constructor, assignment operator,
-//  and destructor. The design and techniques used here are based on the approaches
+//  and destructor, along with a move constructor, move assignment and swap. The design and techniques used here are based on the approaches
 //  described in Michael Main and Walter Savitch's Data Structures and Other Objects Using C++ (4th Edition).
 //  Detailed comments are included to explain every part of the implementation.)
+//
+// INVARIANT for the sequence class (a gap buffer):
+//   0. data points either to buffer (and then capacity == INLINE_CAPACITY)
+//      or to a dynamic array from allocate (and then capacity > INLINE_CAPACITY).
+//   1. The items are stored in data[0..capacity-1] with one gap of unused
+//      slots, data[gap_start..gap_end-1], where gap_start <= gap_end <= capacity.
+//   2. In order, the items of the sequence are data[0] through
+//      data[gap_start-1] followed by data[gap_end] through data[capacity-1],
+//      so the number of items is capacity - (gap_end - gap_start).
+//   3. The gap is at the cursor: if gap_end < capacity, the current item
+//      is data[gap_end]; if gap_end == capacity, there is no current item.
+//   Insertions at the cursor fill the gap from its end, and moving the
+//   cursor moves items from one side of the gap to the other.
 
 #include "sequence2.h"    // Includes the declaration of the sequence class.
+#include <algorithm>      // For swap_ranges
 #include <cassert>        // For assert to check preconditions
+#include <cstdlib>        // For malloc, realloc and free
+#include <cstring>        // For memcpy and memmove
+#include <new>            // For bad_alloc
+#include <type_traits>    // For is_trivially_copyable
+#include <utility>        // For move and swap
+#ifdef __linux__
+#include <sys/mman.h>     // For mmap, mremap and munmap
+#endif
 
 namespace CISP430_A2
 {
+    // -------------------------------------------------------------------------
+    // Storage helpers
+    // Items that are trivially copyable (such as double) are kept in memory
+    // from malloc, so that the array can be grown with realloc; on Linux an
+    // array of at least MAP_BYTES gets pages of its own, which mremap can move
+    // without copying the items. Other items are kept in an array from new[].
+    // Whether an array has its own pages depends only on its capacity, so the
+    // sequence does not need a member to remember it.
+    // -------------------------------------------------------------------------
+    namespace
+    {
+        typedef sequence::value_type item;
+        typedef sequence::size_type count;
+
+        const bool TRIVIAL = std::is_trivially_copyable<item>::value;
+        const std::size_t MAP_BYTES = 1 << 20;
+
+        // Does an array of n items get pages of its own?
+        bool mapped(count n)
+        {
+#ifdef __linux__
+            return TRIVIAL && n * sizeof(item) >= MAP_BYTES;
+#else
+            return false;
+#endif
+        }
+
+        // The size in bytes of an array of n items (never 0, so that malloc
+        // always returns a block).
+        std::size_t bytes(count n)
+        {
+            return (n > 0 ? n : 1) * sizeof(item);
+        }
+
+        // Allocate an array of n items.
+        item* allocate(count n)
+        {
+            if (!TRIVIAL)
+            {
+                return new item[n];
+            }
+#ifdef __linux__
+            if (mapped(n))
+            {
+                void* block = mmap(NULL, bytes(n), PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (block == MAP_FAILED)
+                {
+                    throw std::bad_alloc();
+                }
+                return static_cast<item*>(block);
+            }
+#endif
+            void* block = std::malloc(bytes(n));
+            if (block == NULL)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<item*>(block);
+        }
+
+        // Release an array of n items that came from allocate.
+        void release(item* data, count n)
+        {
+            if (!TRIVIAL)
+            {
+                delete[] data;
+                return;
+            }
+#ifdef __linux__
+            if (mapped(n))
+            {
+                munmap(data, bytes(n));
+                return;
+            }
+#endif
+            std::free(data);
+        }
+
+        // Copy n items to an array that does not overlap the source.
+        void copy_items(item* to, const item* from, count n)
+        {
+            if (n == 0)
+            {
+                return;  // Nothing to copy
+            }
+            if (TRIVIAL)
+            {
+                std::memcpy(to, from, n * sizeof(item));
+                return;
+            }
+            for (count i = 0; i < n; ++i)
+            {
+                to[i] = from[i];
+            }
+        }
+
+        // Exchange the items of two arrays of n items that do not overlap.
+        void swap_items(item* a, item* b, count n)
+        {
+            if (TRIVIAL)
+            {
+                item held[sequence::INLINE_CAPACITY];
+                assert(n <= sequence::INLINE_CAPACITY);
+                std::memcpy(held, a, n * sizeof(item));
+                std::memcpy(a, b, n * sizeof(item));
+                std::memcpy(b, held, n * sizeof(item));
+                return;
+            }
+            std::swap_ranges(a, a + n, b);
+        }
+
+        // Move n items to a higher place in the same array (the two places
+        // may overlap).
+        void move_items_up(item* to, const item* from, count n)
+        {
+            if (n == 0)
+            {
+                return;
+            }
+            if (TRIVIAL)
+            {
+                std::memmove(to, from, n * sizeof(item));
+                return;
+            }
+            for (count i = n; i > 0; --i)
+            {
+                to[i - 1] = from[i - 1];
+            }
+        }
+
+        // Change a trivially copyable array of old_n items into one of new_n
+        // items that starts with the same min(old_n, new_n) items. The bytes
+        // that had to be copied are added to copied.
+        item* reallocate(item* data, count old_n, count new_n, count& copied)
+        {
+            std::size_t keep = (old_n < new_n ? old_n : new_n) * sizeof(item);
+#ifdef __linux__
+            if (mapped(old_n) && mapped(new_n))
+            {
+                // Both arrays have their own pages: move the pages.
+                void* block = mremap(data, bytes(old_n), bytes(new_n), MREMAP_MAYMOVE);
+                if (block == MAP_FAILED)
+                {
+                    throw std::bad_alloc();
+                }
+                return static_cast<item*>(block);
+            }
+            if (mapped(old_n) || mapped(new_n))
+            {
+                // Crossing MAP_BYTES: one copy into the other kind of block.
+                item* block = allocate(new_n);
+                std::memcpy(block, data, keep);
+                release(data, old_n);
+                copied += keep;
+                return block;
+            }
+#endif
+            void* block = std::realloc(data, bytes(new_n));
+            if (block == NULL)
+            {
+                throw std::bad_alloc();
+            }
+            if (block != static_cast<void*>(data))
+            {
+                copied += keep;  // realloc could not grow in place, so it copied
+            }
+            return static_cast<item*>(block);
+        }
+    }
+
     // -------------------------------------------------------------------------
     // Constructor: sequence
     // Purpose: Create a new sequence with an initial capacity (default CAPACITY).
     // Parameters:
     //   entry - The initial capacity for the dynamic array.
     // Postcondition:
-    //   - A dynamic array of size 'entry' is allocated.
-    //   - The number of used elements is initialized to 0.
-    //   - The current index is set to 0.
+    //   - If 'entry' is at most INLINE_CAPACITY, the object's own buffer is
+    //     used; otherwise a dynamic array of size 'entry' is allocated.
+    //   - The whole array is the gap, so the sequence is empty and there is
+    //     no current item.
     // -------------------------------------------------------------------------
     sequence::sequence(size_type entry)
-        : used(0), capacity(entry), current_index(0)
+        : capacity(entry > size_type(INLINE_CAPACITY) ? entry : size_type(INLINE_CAPACITY)),
+          gap_start(0),
+          growth(GROW_BY_HALF), chunk(CAPACITY), policy(NULL),
+          realloc_count(0), copied_bytes(0)
     {
-        // Allocate a dynamic array for storing the sequence items.
-        data = new value_type[capacity];
+        // Use the buffer, or allocate a dynamic array for storing the sequence items.
+        data = (capacity == INLINE_CAPACITY) ? buffer : allocate(capacity);
+        gap_end = capacity;
     }
 
     // -------------------------------------------------------------------------
@@ -35,45 +234,89 @@ namespace CISP430_A2
     // Parameters:
     //   entry - The sequence to be copied.
     // Postcondition:
-    //   - A new dynamic array is allocated with the same capacity as 'entry'.
-    //   - All items from 'entry' are copied.
-    //   - The used count and current index are copied.
+    //   - A new dynamic array is allocated with the same capacity as 'entry'
+    //     (or the object's own buffer is used, if 'entry' uses its buffer).
+    //   - All items from 'entry' are copied, on the same sides of the gap.
+    //   - The gap (and so the current item) is in the same place.
+    //   - The growth policy is copied; the counters start at zero.
     // -------------------------------------------------------------------------
     sequence::sequence(const sequence& entry)
-        : used(entry.used), capacity(entry.capacity), current_index(entry.current_index)
+        : capacity(entry.capacity), gap_start(entry.gap_start), gap_end(entry.gap_end),
+          growth(entry.growth), chunk(entry.chunk), policy(entry.policy),
+          realloc_count(0), copied_bytes(0)
     {
         // Allocate new dynamic memory with the same capacity as the original sequence.
-        data = new value_type[capacity];
-        // Copy each item from the original sequence into the new array.
-        for (size_type i = 0; i < used; ++i)
+        data = entry.is_inline() ? buffer : allocate(capacity);
+        // Copy the items before and after the gap from the original sequence.
+        copy_items(data, entry.data, gap_start);
+        copy_items(data + gap_end, entry.data + gap_end, capacity - gap_end);
+    }
+
+    // -------------------------------------------------------------------------
+    // Move Constructor: sequence
+    // Purpose: Create a sequence that takes over the contents of a temporary.
+    // Parameters:
+    //   source - The sequence to be moved from.
+    // Postcondition:
+    //   - This sequence has the array, gap, growth policy and counters that
+    //     source had. A dynamic array is taken over by pointer; if source
+    //     uses its buffer, only the items in it are copied.
+    //   - source is empty and uses its own buffer.
+    // -------------------------------------------------------------------------
+    sequence::sequence(sequence&& source) noexcept
+        : data(buffer), capacity(source.capacity),
+          gap_start(source.gap_start), gap_end(source.gap_end),
+          growth(source.growth), chunk(source.chunk), policy(source.policy),
+          realloc_count(source.realloc_count), copied_bytes(source.copied_bytes)
+    {
+        if (source.is_inline())
         {
-            data[i] = entry.data[i];
+            // Copy the items on both sides of the gap into this buffer.
+            copy_items(buffer, source.buffer, gap_start);
+            copy_items(buffer + gap_end, source.buffer + gap_end, capacity - gap_end);
         }
+        else
+        {
+            // Take the dynamic array; source goes back to its buffer.
+            data = source.data;
+            source.data = source.buffer;
+            source.capacity = INLINE_CAPACITY;
+        }
+        source.gap_start = 0;
+        source.gap_end = source.capacity;
+        source.realloc_count = 0;
+        source.copied_bytes = 0;
     }
 
     // -------------------------------------------------------------------------
     // Destructor: ~sequence
     // Purpose: Release the dynamic memory allocated for the sequence.
     // Postcondition:
-    //   - The dynamic array is deallocated.
+    //   - The dynamic array, if there is one, is deallocated.
     // -------------------------------------------------------------------------
     sequence::~sequence()
     {
-        delete[] data;
+        if (!is_inline())
+        {
+            release(data, capacity);
+        }
     }
 
     // -------------------------------------------------------------------------
     // Member Function: start
-    // Purpose: Set the current index to the first element of the sequence.
+    // Purpose: Make the first element of the sequence the current item.
     // Postcondition:
     //   - If the sequence is not empty, the first item becomes the current item.
+    //   - The items that were before the gap have been moved to just after it
+    //     (with one memmove for trivially copyable items), so the gap is at
+    //     the front of the array.
     // -------------------------------------------------------------------------
     void sequence::start()
     {
-        if (used > 0)
-        {
-            current_index = 0;
-        }
+        // Move the items before the gap across it.
+        gap_end -= gap_start;
+        move_items_up(data + gap_end, data, gap_start);
+        gap_start = 0;
     }
 
     // -------------------------------------------------------------------------
@@ -82,14 +325,15 @@ namespace CISP430_A2
     // Precondition:
     //   - is_item() must return true (i.e., there is a valid current item).
     // Postcondition:
-    //   - The current index is incremented.
+    //   - The current item has been moved from just after the gap to just
+    //     before it, so the item that followed it is now the current item.
     //   - If the current item was the last element, there is no current item.
     // -------------------------------------------------------------------------
     void sequence::advance()
     {
         // Ensure there is a current item.
         assert(is_item());
-        ++current_index;
+        data[gap_start++] = data[gap_end++];
     }
 
     // -------------------------------------------------------------------------
@@ -100,38 +344,27 @@ namespace CISP430_A2
     // Postcondition:
     //   - If no current item exists, the new entry is inserted at the beginning.
     //   - Otherwise, the entry is inserted just before the current item.
-    //   - If the dynamic array is full, it is resized (increased by at least 10%).
+    //   - If the dynamic array is full, it is grown by the growth policy.
     //   - The newly inserted entry becomes the current item.
+    //   - No items are shifted: the entry goes in the last slot of the gap
+    //     (unless there was no current item, when the gap is moved to the front).
     // -------------------------------------------------------------------------
     void sequence::insert(const value_type& entry)
     {
-        // If the array is full, resize it by increasing its capacity by at least 10%.
-        if (used >= capacity)
+        // If the array is full, grow it by the growth policy.
+        if (gap_start == gap_end)
         {
-            size_type increase = capacity / 10;
-            if (increase == 0)
-            {
-                increase = 1; // Ensure at least one extra space if capacity is small.
-            }
-            resize(capacity + increase);
+            grow(1);
         }
 
         // If there is no current item, insert at the beginning.
         if (!is_item())
         {
-            current_index = 0;
-        }
-
-        // Shift all items starting at current_index one position to the right
-        // to create space for the new entry.
-        for (size_type i = used; i > current_index; --i)
-        {
-            data[i] = data[i - 1];
+            start();
         }
 
-        // Insert the new entry at the current_index.
-        data[current_index] = entry;
-        ++used;  // Increase the count of used elements.
+        // The new entry goes just before the current item, and becomes current.
+        data[--gap_end] = entry;
     }
 
     // -------------------------------------------------------------------------
@@ -142,42 +375,28 @@ namespace CISP430_A2
     // Postcondition:
     //   - If no current item exists, the new entry is appended at the end.
     //   - Otherwise, the entry is inserted immediately after the current item.
-    //   - If the dynamic array is full, it is resized (increased by at least 10%).
+    //   - If the dynamic array is full, it is grown by the growth policy.
     //   - The newly attached entry becomes the current item.
+    //   - No items are shifted: the old current item moves to the front of the
+    //     gap, and the entry goes in the last slot of the gap.
     // -------------------------------------------------------------------------
     void sequence::attach(const value_type& entry)
     {
-        // If the array is full, resize it.
-        if (used >= capacity)
+        // If the array is full, grow it by the growth policy.
+        if (gap_start == gap_end)
         {
-            size_type increase = capacity / 10;
-            if (increase == 0)
-            {
-                increase = 1;
-            }
-            resize(capacity + increase);
+            grow(1);
         }
 
-        // Determine the index for the new entry:
-        // If a current item exists, attach after it; otherwise, attach at the end.
+        // If a current item exists, attach after it by first moving it before
+        // the gap; otherwise the gap is already at the end of the sequence.
         if (is_item())
         {
-            ++current_index;
-        }
-        else
-        {
-            current_index = used;
-        }
-
-        // Shift all items from current_index onward one position to the right.
-        for (size_type i = used; i > current_index; --i)
-        {
-            data[i] = data[i - 1];
+            advance();
         }
 
-        // Insert the new entry at the current_index.
-        data[current_index] = entry;
-        ++used;  // Update the used count.
+        // The new entry goes just after the gap, and becomes current.
+        data[--gap_end] = entry;
     }
 
     // -------------------------------------------------------------------------
@@ -186,8 +405,7 @@ namespace CISP430_A2
     // Precondition:
     //   - is_item() must return true.
     // Postcondition:
-    //   - The current item is removed.
-    //   - All subsequent items are shifted one position to the left.
+    //   - The current item is removed (its slot joins the gap).
     //   - The item that followed the removed item becomes the new current item.
     // -------------------------------------------------------------------------
     void sequence::remove_current()
@@ -195,13 +413,159 @@ namespace CISP430_A2
         // Ensure there is a current item to remove.
         assert(is_item());
 
-        // Shift items leftward to overwrite the current item.
-        for (size_type i = current_index; i < used - 1; ++i)
+        // Widen the gap over the current item; if gap_end is now capacity,
+        // there is no current item.
+        ++gap_end;
+    }
+
+    // -------------------------------------------------------------------------
+    // Member Function: insert_range
+    // Purpose: Insert an array of entries before the current item.
+    // Parameters:
+    //   first, last - The entries to be inserted, [first, last).
+    // Precondition:
+    //   - The entries are not part of this sequence.
+    // Postcondition:
+    //   - The entries are inserted, in order, before the current item, or at
+    //     the front if there is no current item.
+    //   - The first entry becomes the current item.
+    //   - The array is grown at most once, and the entries are copied into
+    //     the end of the gap with a single copy; no items are shifted.
+    // -------------------------------------------------------------------------
+    void sequence::insert_range(const value_type* first, const value_type* last)
+    {
+        assert(first <= last);
+        size_type count = last - first;
+        if (count == 0)
         {
-            data[i] = data[i + 1];
+            return;
         }
-        --used;  // Decrement the count of used items.
-        // current_index remains unchanged; if it now equals used, there is no current item.
+
+        // Make the gap big enough for all of the entries.
+        if (gap_end - gap_start < count)
+        {
+            grow(count);
+        }
+
+        // If there is no current item, insert at the beginning.
+        if (!is_item())
+        {
+            start();
+        }
+
+        // The entries fill the end of the gap, so the first becomes current.
+        gap_end -= count;
+        copy_items(data + gap_end, first, count);
+    }
+
+    // -------------------------------------------------------------------------
+    // Member Function: attach_range
+    // Purpose: Insert an array of entries after the current item.
+    // Parameters:
+    //   first, last - The entries to be attached, [first, last).
+    // Precondition:
+    //   - The entries are not part of this sequence.
+    // Postcondition:
+    //   - The entries are inserted, in order, after the current item, or at
+    //     the end if there is no current item.
+    //   - The last entry becomes the current item.
+    //   - The array is grown at most once; all entries but the last are
+    //     copied to the front of the gap, and the last to its end.
+    // -------------------------------------------------------------------------
+    void sequence::attach_range(const value_type* first, const value_type* last)
+    {
+        assert(first <= last);
+        size_type count = last - first;
+        if (count == 0)
+        {
+            return;
+        }
+
+        // Make the gap big enough for all of the entries.
+        if (gap_end - gap_start < count)
+        {
+            grow(count);
+        }
+
+        // If a current item exists, move it before the gap so that the
+        // entries follow it; otherwise the gap is already at the end.
+        if (is_item())
+        {
+            advance();
+        }
+
+        // All but the last entry go before the gap; the last one is current.
+        copy_items(data + gap_start, first, count - 1);
+        gap_start += count - 1;
+        data[--gap_end] = last[-1];
+    }
+
+    // -------------------------------------------------------------------------
+    // Member Function: remove_range
+    // Purpose: Remove a number of items, starting with the current item.
+    // Parameters:
+    //   count - The number of items to be removed.
+    // Precondition:
+    //   - There are at least 'count' items from the current item on.
+    // Postcondition:
+    //   - The items are removed (their slots join the gap), and the item that
+    //     followed them becomes the current item.
+    // -------------------------------------------------------------------------
+    void sequence::remove_range(size_type count)
+    {
+        assert(count <= capacity - gap_end);
+        gap_end += count;
+    }
+
+    // -------------------------------------------------------------------------
+    // Member Function: remove_if
+    // Purpose: Remove every item that passes a test.
+    // Parameters:
+    //   test - Returns true for the items to be removed.
+    // Postcondition:
+    //   - The items before the gap have been packed towards the front of the
+    //     array and those after it towards the end, each kept item being
+    //     moved at most once, so the gap grows by the number removed.
+    //   - The current item, if kept, is still current; otherwise the next
+    //     kept item after it (if any) is.
+    //   - Returns the number of items removed.
+    // -------------------------------------------------------------------------
+    sequence::size_type sequence::remove_if(predicate test)
+    {
+        size_type before = size();
+
+        // Pack the items before the gap towards the front.
+        size_type kept = 0;
+        for (size_type i = 0; i < gap_start; ++i)
+        {
+            if (!test(data[i]))
+            {
+                if (kept != i)
+                {
+                    data[kept] = data[i];
+                }
+                ++kept;
+            }
+        }
+        gap_start = kept;
+
+        // Pack the items after the gap towards the end, so that the first
+        // one kept (the new current item) is just after the gap.
+        kept = capacity;
+        for (size_type i = capacity; i > gap_end; --i)
+        {
+            if (!test(data[i - 1]))
+            {
+                --kept;
+                if (kept != i - 1)
+                {
+                    data[kept] = data[i - 1];
+                }
+            }
+        }
+        gap_end = kept;
+
+        return before - size();
     }
 
     // -------------------------------------------------------------------------
@@ -209,87 +573,274 @@ namespace CISP430_A2
     // Purpose: Change the capacity of the sequence.
     // Parameters:
     //   new_capacity - The new capacity for the dynamic array.
-    // Precondition:
-    //   - new_capacity must be greater than the number of used items.
     // Postcondition:
-    //   - A new dynamic array of size new_capacity is allocated.
-    //   - All existing items are copied to the new array.
-    //   - The old dynamic array is deallocated.
+    //   - A new_capacity smaller than size() is taken to be size(), so no
+    //     item is ever lost.
+    //   - The array holds new_capacity items (or INLINE_CAPACITY items in the
+    //     object's own buffer, if new_capacity is not more than that): the
+    //     items before the gap are at its front and those after the gap at
+    //     its end, so the cursor stays where it was and the change in size is
+    //     taken up by the gap.
+    //   - Trivially copyable items in a dynamic array are resized in place
+    //     with realloc (or mremap), so only the items after the gap are sure
+    //     to be moved; otherwise the items are copied to the new array and
+    //     the old one, unless it is the buffer, is deallocated.
+    //   - reallocations() and bytes_copied() count the work done.
+    //   - If the new array cannot be allocated, bad_alloc is thrown and the
+    //     sequence is unchanged.
     // -------------------------------------------------------------------------
     void sequence::resize(size_type new_capacity)
     {
-        // Verify that the new capacity is valid.
-        assert(new_capacity > used);
-
-        // Allocate a new dynamic array with the new capacity.
-        value_type* new_data = new value_type[new_capacity];
-
-        // Copy all existing items into the new array.
-        for (size_type i = 0; i < used; ++i)
+        // Never make the array too small for the items, and only then
+        // decide whether they fit in the buffer.
+        if (new_capacity < size())
+        {
+            new_capacity = size();
+        }
+        if (new_capacity < INLINE_CAPACITY)
         {
-            new_data[i] = data[i];
+            new_capacity = INLINE_CAPACITY;  // Small arrays use the buffer
+        }
+        if (new_capacity == capacity)
+        {
+            return;
         }
 
-        // Deallocate the old array.
-        delete[] data;
+        size_type after = capacity - gap_end;
+        size_type after_bytes = after * sizeof(value_type);
+        if (TRIVIAL && !is_inline() && new_capacity != INLINE_CAPACITY)
+        {
+            // Move the items after the gap to the end of the array: before
+            // the array shrinks, or after it grows.
+            bool shrinking = new_capacity < capacity && after > 0;
+            if (shrinking)
+            {
+                std::memmove(data + new_capacity - after, data + gap_end, after_bytes);
+            }
+            try
+            {
+                data = reallocate(data, capacity, new_capacity, copied_bytes);
+            }
+            catch (...)
+            {
+                // The old array is unchanged: put the items back after the gap.
+                if (shrinking)
+                {
+                    std::memmove(data + gap_end, data + new_capacity - after, after_bytes);
+                }
+                throw;
+            }
+            if (new_capacity > capacity && after > 0)
+            {
+                std::memmove(data + new_capacity - after, data + gap_end, after_bytes);
+            }
+            copied_bytes += after_bytes;
+        }
+        else
+        {
+            // Copy the items before the gap, then the items after the gap,
+            // into or out of the buffer (or to a new array).
+            value_type* new_data = (new_capacity == INLINE_CAPACITY) ? buffer : allocate(new_capacity);
+            copy_items(new_data, data, gap_start);
+            copy_items(new_data + new_capacity - after, data + gap_end, after);
+            if (!is_inline())
+            {
+                release(data, capacity);
+            }
+            data = new_data;
+            copied_bytes += gap_start * sizeof(value_type) + after_bytes;
+        }
 
-        // Update data pointer and capacity.
-        data = new_data;
+        // Update the capacity, the end of the gap and the counter.
         capacity = new_capacity;
+        gap_end = new_capacity - after;
+        ++realloc_count;
+    }
+
+    // -------------------------------------------------------------------------
+    // Member Function: set_growth
+    // Purpose: Choose one of the built-in growth policies.
+    // Parameters:
+    //   kind  - The policy.
+    //   chunk - The number of items added by GROW_BY_CHUNK.
+    // Precondition:
+    //   - chunk > 0.
+    // Postcondition:
+    //   - A full array will grow by the chosen policy.
+    // -------------------------------------------------------------------------
+    void sequence::set_growth(growth_kind kind, size_type chunk)
+    {
+        assert(chunk > 0);
+        growth = kind;
+        this->chunk = chunk;
+        policy = NULL;
+    }
+
+    // -------------------------------------------------------------------------
+    // Member Function: set_growth
+    // Purpose: Choose a growth policy supplied by the caller.
+    // Parameters:
+    //   policy - A function from the capacity of a full array to its new capacity.
+    // Precondition:
+    //   - policy is not NULL.
+    // Postcondition:
+    //   - A full array will grow to policy(capacity) items.
+    // -------------------------------------------------------------------------
+    void sequence::set_growth(growth_function policy)
+    {
+        assert(policy != NULL);
+        this->policy = policy;
+    }
+
+    // -------------------------------------------------------------------------
+    // Helper Function: grow
+    // Purpose: Make room for at least 'needed' more items, with one resize.
+    // Parameters:
+    //   needed - The number of items that must fit in the gap.
+    // Postcondition:
+    //   - The array has been resized to the capacity given by the growth
+    //     policy, or to size() + needed if that is larger.
+    // -------------------------------------------------------------------------
+    void sequence::grow(size_type needed)
+    {
+        size_type new_capacity;
+        if (policy != NULL)
+        {
+            new_capacity = policy(capacity);
+        }
+        else
+        {
+            switch (growth)
+            {
+                case GROW_BY_DOUBLING: new_capacity = 2 * capacity;
+                                       break;
+                case GROW_BY_CHUNK:    new_capacity = capacity + chunk;
+                                       break;
+                case GROW_BY_TENTH:    new_capacity = capacity + capacity / 10;
+                                       break;
+                default:               new_capacity = capacity + capacity / 2;
+                                       break;
+            }
+        }
+        if (new_capacity < size() + needed)
+        {
+            new_capacity = size() + needed;  // Always make room for the items.
+        }
+        resize(new_capacity);
     }
 
     // -------------------------------------------------------------------------
     // Member Function: operator=
     // Purpose: Overload the assignment operator to assign one sequence to another.
     // Parameters:
-    //   other - The sequence object on the right-hand side.
+    //   source - The sequence object on the right-hand side.
     // Precondition:
     //   - Self-assignment is handled.
     // Postcondition:
-    //   - The current sequence becomes a deep copy of 'other'.
+    //   - The current sequence becomes a deep copy of 'source'.
+    //   - The copy is made before anything is changed (copy and swap), so if
+    //     it cannot be allocated this sequence is left as it was.
     // -------------------------------------------------------------------------
-    void sequence::operator=(const sequence& other)
+    sequence& sequence::operator=(const sequence& source)
     {
         // Handle self-assignment.
-        if (this == &other)
-            return;
-
-        // Deallocate the existing dynamic array.
-        delete[] data;
+        if (this != &source)
+        {
+            // Copy source, then trade arrays with the copy; the copy's
+            // destructor releases the old array.
+            sequence copy(source);
+            swap(copy);
+        }
+        return *this;
+    }
 
-        // Copy over the capacity, number of used items, and current index.
-        capacity = other.capacity;
-        used = other.used;
-        current_index = other.current_index;
+    // -------------------------------------------------------------------------
+    // Member Function: operator= (move)
+    // Purpose: Assign a temporary sequence to this one without copying items.
+    // Parameters:
+    //   source - The sequence to be moved from.
+    // Postcondition:
+    //   - This sequence has the contents that source had.
+    //   - source is empty and uses its own buffer, as after the move
+    //     constructor; this sequence's old array has been released.
+    //   - Moving a sequence to itself leaves it as it was.
+    // -------------------------------------------------------------------------
+    sequence& sequence::operator=(sequence&& source) noexcept
+    {
+        // Empty source into a temporary, then trade with it; the temporary's
+        // destructor releases the old array.
+        sequence taken(std::move(source));
+        swap(taken);
+        return *this;
+    }
 
-        // Allocate a new dynamic array and copy items from 'other'.
-        data = new value_type[capacity];
-        for (size_type i = 0; i < used; ++i)
+    // -------------------------------------------------------------------------
+    // Member Function: swap
+    // Purpose: Exchange the contents of two sequences.
+    // Parameters:
+    //   other - The sequence to exchange with.
+    // Postcondition:
+    //   - The arrays, gaps, growth policies and counters of the two sequences
+    //     have been exchanged. Dynamic arrays are exchanged by pointer; if
+    //     either sequence uses its buffer, the buffers' items are exchanged
+    //     and each data pointer is aimed at the right buffer.
+    // -------------------------------------------------------------------------
+    void sequence::swap(sequence& other) noexcept
+    {
+        if (&other == this)
+        {
+            return;  // The buffers would overlap
+        }
+        bool mine_inline = is_inline();
+        bool other_inline = other.is_inline();
+        if (mine_inline || other_inline)
         {
-            data[i] = other.data[i];
+            swap_items(buffer, other.buffer, INLINE_CAPACITY);
         }
+        value_type* mine = data;
+        data = other_inline ? buffer : other.data;
+        other.data = mine_inline ? other.buffer : mine;
+        std::swap(capacity, other.capacity);
+        std::swap(gap_start, other.gap_start);
+        std::swap(gap_end, other.gap_end);
+        std::swap(growth, other.growth);
+        std::swap(chunk, other.chunk);
+        std::swap(policy, other.policy);
+        std::swap(realloc_count, other.realloc_count);
+        std::swap(copied_bytes, other.copied_bytes);
+    }
+
+    // -------------------------------------------------------------------------
+    // Non-Member Function: swap
+    // Purpose: Let swap(a, b) find the constant-time member swap.
+    // Postcondition:
+    //   - a.swap(b) has been called.
+    // -------------------------------------------------------------------------
+    void swap(sequence& a, sequence& b) noexcept
+    {
+        a.swap(b);
     }
 
     // -------------------------------------------------------------------------
     // Member Function: size
     // Purpose: Return the number of items in the sequence.
     // Postcondition:
-    //   - Returns the value of the 'used' member variable.
+    //   - Returns the capacity less the size of the gap.
     // -------------------------------------------------------------------------
     sequence::size_type sequence::size() const
     {
-        return used;
+        return capacity - (gap_end - gap_start);
     }
 
     // -------------------------------------------------------------------------
     // Member Function: is_item
     // Purpose: Check if there is a valid current item.
     // Postcondition:
-    //   - Returns true if current_index is less than used; otherwise, false.
+    //   - Returns true if there is an item after the gap; otherwise, false.
     // -------------------------------------------------------------------------
     bool sequence::is_item() const
     {
-        return current_index < used;
+        return gap_end < capacity;
     }
 
     // -------------------------------------------------------------------------
@@ -298,12 +849,12 @@ namespace CISP430_A2
     // Precondition:
     //   - is_item() must return true.
     // Postcondition:
-    //   - Returns the item at the current index.
+    //   - Returns the item just after the gap.
     // -------------------------------------------------------------------------
     sequence::value_type sequence::current() const
     {
         // Ensure that a current item exists.
         assert(is_item());
-        return data[current_index];
+        return data[gap_end];
     }
 } // End namespace CISP430_A2
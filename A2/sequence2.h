@@ -1,128 +1,260 @@
-// FILE: sequence1.h
-// CLASS PROVIDED: sequence (part of the namespace CISP430_A2)
-// There is no implementation file provided for this class since it is
-// an exercise from Section 3.2 of "Data Structures and Other Objects Using C++"
-//
-// TYPEDEFS and MEMBER CONSTANTS for the sequence class:
-//   typedef ____ value_type
-//     sequence::value_type is the data type of the items in the sequence. It
-//     may be any of the C++ built-in types (int, char, etc.), or a class with a
-//     default constructor, an assignment operator, and a copy constructor.
-//
-//   typedef ____ size_type
-//     sequence::size_type is the data type of any variable that keeps track of
-//     how many items are in a sequence.
-//
-//   enum { CAPACITY = 30 };
-//     CAPACITY is the maximum number of items that a sequence can hold.
-//
-// CONSTRUCTOR for the sequence class:
-//   sequence(size_type entry=CAPACITY );
-//     Postcondition: The sequence has been dynamic allocate memories.
-//
-//COPY CONSTRUCTOR
-//   sequence(const sequence& entry)
-//   Postcondition: The sequence has been created by copying from an existing sequence.
-//
-// MODIFICATION MEMBER FUNCTIONS for the sequence class:
-//   void start( )
-//     Postcondition: The first item on the sequence becomes the current item
-//     (but if the sequence is empty, then there is no current item).
-//
-//   void advance( )
-//     Precondition: is_item returns true.
-//     Postcondition: If the current item was already the last item in the
-//     sequence, then there is no longer any current item. Otherwise, the new
-//     current item is the item immediately after the original current item.
-//
-//   void insert(const value_type& entry)
-//     Precondition: size( ) < CAPACITY. if this is not true then increase the capacity by 10%
-//     Postcondition: A new copy of entry has been inserted in the sequence
-//     before the current item. If there was no current item, then the new entry 
-//     has been inserted at the front of the sequence. In either case, the newly
-//     inserted item is now the current item of the sequence.
-//
-//   void attach(const value_type& entry)
-//     Precondition: size( ) < CAPACITY.if this is not true then increase the capacity by 10%
-//     Postcondition: A new copy of entry has been inserted in the sequence after
-//     the current item. If there was no current item, then the new entry has 
-//     been attached to the end of the sequence. In either case, the newly
-//     inserted item is now the current item of the sequence.
-//
-//   void remove_current( )
-//     Precondition: is_item returns true.
-//     Postcondition: The current item has been removed from the sequence, and the
-//     item after this (if there is one) is now the new current item.
-//
-//Operator= overloading
-//   void sequence::operator =(const sequence&);
-//     Postcondition:  The r-value's sequence object is copy to the l-value
-//
-// CONSTANT MEMBER FUNCTIONS for the sequence class:
-//   size_type size( ) const
-//     Postcondition: The return value is the number of items in the sequence.
-//
-//   bool is_item( ) const
-//     Postcondition: A true return value indicates that there is a valid
-//     "current" item that may be retrieved by activating the current
-//     member function (listed below). A false return value indicates that
-//     there is no valid current item.
-//
-//   value_type current( ) const
-//     Precondition: is_item( ) returns true.
-//     Postcondition: The item returned is the current item in the sequence.
-// Destructor
-//	 ~sequence()  
-//     Postcondition: release the memory to the heap
-//
-// VALUE SEMANTICS for the sequence class:
-//    Assignments and the copy constructor may be used with sequence objects.
-//
-//void resize(size_type new_capacity )
-//Precondition: new_capacity > used
-// Postcondition: new space allocated and old space released
-   
-
-#ifndef SEQUENCE_H
-#define SEQUENCE_H
-#include <cstdlib>  // Provides size_t
-
-namespace CISP430_A2
-{
-    class sequence
-    {
-    public:
-        // TYPEDEFS and MEMBER CONSTANTS
-        typedef double value_type;
-        typedef size_t size_type;
-        enum { CAPACITY = 30 };
-        // CONSTRUCTOR
-        sequence(size_type entry=CAPACITY );
-		   // COPY CONSTRUCTOR
-        sequence(const sequence& entry)   ;       
-    // Library facilities used: cstdlib
-        // MODIFICATION MEMBER FUNCTIONS
-        void start( );
-        void advance( );
-        void insert(const value_type& entry);
-        void attach(const value_type& entry);
-        void remove_current( );
-		void resize(size_type );
-		//void sequence::operator =(const sequence&);
-		void operator =(const sequence&);
-        // CONSTANT MEMBER FUNCTIONS
-        size_type size( ) const;
-        bool is_item( ) const;
-        value_type current( ) const;
-		//Destructor
-		 ~sequence()  ;
-    private:
-        value_type *data;
-        size_type used;
-		size_type capacity;
-        size_type current_index;
-    };
-}
-
-#endif
-
+// FILE: sequence1.h
+// CLASS PROVIDED: sequence (part of the namespace CISP430_A2)
+// There is no implementation file provided for this class since it is
+// an exercise from Section 3.2 of "Data Structures and Other Objects Using C++"
+//
+// The items are kept in a gap buffer: the unused part of the array sits at
+// the cursor, so insert, attach and remove_current take constant time
+// (plus the occasional resize), and start and advance cost only the number
+// of items the cursor moves past.
+//
+// When the array is full it grows by a growth policy: by half its size
+// (the default), by doubling, by a fixed chunk, by 10% (the original rule),
+// or by a function supplied by the caller. Growing by a fixed fraction
+// means that filling a sequence with N items copies O(N) items in all.
+// When value_type is trivially copyable, the array is kept in malloc'ed
+// memory and grown with realloc, and (on Linux) arrays of 1 MB and more
+// get their own pages and are grown with mremap, which moves the pages
+// without copying the items.
+//
+// A sequence with room for at most INLINE_CAPACITY items keeps them in an
+// array inside the object itself, so that a short sequence (including one
+// made with the default capacity) never touches the heap. The items move
+// to a dynamic array only when the sequence outgrows that buffer.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the sequence class:
+//   typedef ____ value_type
+//     sequence::value_type is the data type of the items in the sequence. It
+//     may be any of the C++ built-in types (int, char, etc.), or a class with a
+//     default constructor, an assignment operator, and a copy constructor.
+//
+//   typedef ____ size_type
+//     sequence::size_type is the data type of any variable that keeps track of
+//     how many items are in a sequence.
+//
+//   enum { CAPACITY = 30 };
+//     CAPACITY is the maximum number of items that a sequence can hold.
+//
+//   enum { INLINE_CAPACITY = CAPACITY };
+//     INLINE_CAPACITY is the number of items that fit in the buffer inside the
+//     sequence object. Its capacity is never less than this.
+//
+//   enum growth_kind { GROW_BY_HALF, GROW_BY_DOUBLING, GROW_BY_CHUNK, GROW_BY_TENTH };
+//     The built-in growth policies: a full array of capacity c grows to
+//     c + c/2, 2c, c + chunk, or c + c/10 items (always by at least one).
+//
+//   typedef size_type (*growth_function)(size_type capacity)
+//     A growth policy supplied by the caller: given the capacity of a full
+//     array, it returns the new capacity (if that is not larger, the array
+//     grows by one item).
+//
+//   typedef bool (*predicate)(const value_type& item)
+//     A test for remove_if: it returns true for the items to be removed.
+//
+// CONSTRUCTOR for the sequence class:
+//   sequence(size_type entry=CAPACITY );
+//     Postcondition: The sequence has been dynamic allocate memories (or, if
+//     entry <= INLINE_CAPACITY, it uses its own buffer and allocates nothing).
+//
+//COPY CONSTRUCTOR
+//   sequence(const sequence& entry)
+//   Postcondition: The sequence has been created by copying from an existing sequence.
+//
+//MOVE CONSTRUCTOR
+//   sequence(sequence&& source)
+//   Postcondition: The sequence has taken over the array, cursor, growth policy and
+//   counters of source. Only items held in source's own buffer are copied. source
+//   is left empty, using its own buffer.
+//
+// MODIFICATION MEMBER FUNCTIONS for the sequence class:
+//   void start( )
+//     Postcondition: The first item on the sequence becomes the current item
+//     (but if the sequence is empty, then there is no current item).
+//
+//   void advance( )
+//     Precondition: is_item returns true.
+//     Postcondition: If the current item was already the last item in the
+//     sequence, then there is no longer any current item. Otherwise, the new
+//     current item is the item immediately after the original current item.
+//
+//   void insert(const value_type& entry)
+//     Precondition: size( ) < CAPACITY. if this is not true then grow the capacity by the growth policy
+//     Postcondition: A new copy of entry has been inserted in the sequence
+//     before the current item. If there was no current item, then the new entry 
+//     has been inserted at the front of the sequence. In either case, the newly
+//     inserted item is now the current item of the sequence.
+//
+//   void attach(const value_type& entry)
+//     Precondition: size( ) < CAPACITY.if this is not true then grow the capacity by the growth policy
+//     Postcondition: A new copy of entry has been inserted in the sequence after
+//     the current item. If there was no current item, then the new entry has 
+//     been attached to the end of the sequence. In either case, the newly
+//     inserted item is now the current item of the sequence.
+//
+//   void remove_current( )
+//     Precondition: is_item returns true.
+//     Postcondition: The current item has been removed from the sequence, and the
+//     item after this (if there is one) is now the new current item.
+//
+//   void insert_range(const value_type* first, const value_type* last)
+//     Precondition: [first, last) is an array of items that is not part of this
+//     sequence.
+//     Postcondition: Copies of the items have been inserted, in order, before the
+//     current item (or at the front if there was no current item), and the first
+//     of them is now the current item. If the range is empty, nothing changes.
+//     The array grows at most once, and no items of the sequence are moved.
+//
+//   void attach_range(const value_type* first, const value_type* last)
+//     Precondition: the same as for insert_range.
+//     Postcondition: Copies of the items have been inserted, in order, after the
+//     current item (or at the end if there was no current item), and the last of
+//     them is now the current item. If the range is empty, nothing changes. The
+//     array grows at most once, and only the old current item is moved.
+//
+//   void remove_range(size_type count)
+//     Precondition: count items, starting with the current item, are in the
+//     sequence (count may be 0).
+//     Postcondition: Those items have been removed, and the item after them (if
+//     there is one) is now the current item. No items are moved.
+//
+//   size_type remove_if(predicate test)
+//     Postcondition: Every item for which test returns true has been removed, and
+//     the return value is how many were removed. If the current item was kept it
+//     is still the current item; otherwise the next item that was kept (if any)
+//     is. Each remaining item is moved at most once.
+//
+//   void set_growth(growth_kind kind, size_type chunk = CAPACITY)
+//     Precondition: chunk > 0
+//     Postcondition: The array will grow by the built-in policy kind (with
+//     the given chunk for GROW_BY_CHUNK) whenever it is full.
+//
+//   void set_growth(growth_function policy)
+//     Precondition: policy is not NULL
+//     Postcondition: The array will grow to policy(capacity) items whenever
+//     it is full.
+//
+//Operator= overloading
+//   sequence& operator =(const sequence& source);
+//     Postcondition:  The r-value's sequence object is copy to the l-value (copy and
+//     swap: if the copy cannot be allocated, the l-value is unchanged). The return
+//     value is the l-value.
+//   sequence& operator =(sequence&& source);
+//     Postcondition:  The l-value has taken over the contents of source, as with the
+//     move constructor (only items held in source's own buffer are copied), and its
+//     old array has been released. source is left empty, using its own buffer. The
+//     return value is the l-value.
+//
+//   void swap(sequence& other)
+//     Postcondition: This sequence and other have exchanged their arrays, cursors,
+//     growth policies and counters. Dynamic arrays are exchanged by pointer, and
+//     items in the objects' own buffers are exchanged item by item.
+//
+// CONSTANT MEMBER FUNCTIONS for the sequence class:
+//   size_type size( ) const
+//     Postcondition: The return value is the number of items in the sequence.
+//
+//   bool is_item( ) const
+//     Postcondition: A true return value indicates that there is a valid
+//     "current" item that may be retrieved by activating the current
+//     member function (listed below). A false return value indicates that
+//     there is no valid current item.
+//
+//   value_type current( ) const
+//     Precondition: is_item( ) returns true.
+//     Postcondition: The item returned is the current item in the sequence.
+//
+//   size_type reallocations( ) const
+//   size_type bytes_copied( ) const
+//     Postcondition: The return value is how many times the array has been
+//     resized, or how many bytes of items have been copied in resizing it
+//     (including the copy made by realloc when the block moves, but not
+//     pages moved by mremap). A copy of a sequence starts both at zero.
+// Destructor
+//	 ~sequence()  
+//     Postcondition: release the memory to the heap
+//
+// VALUE SEMANTICS for the sequence class:
+//    Assignments and the copy constructor may be used with sequence objects.
+//    The growth policy is copied along with the items. Sequences that are returned
+//    from functions or passed as temporaries are moved, not copied.
+//
+// NON-MEMBER FUNCTION for the sequence class:
+//   void swap(sequence& a, sequence& b)
+//     Postcondition: a.swap(b) has been called.
+//
+//void resize(size_type new_capacity )
+// Postcondition: new space allocated and old space released (a new_capacity of at
+// most INLINE_CAPACITY moves the items into the object's own buffer). If
+// new_capacity < size( ), size( ) is used instead, so no items are lost.
+   
+
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+#include <cstdlib>  // Provides size_t
+
+namespace CISP430_A2
+{
+    class sequence
+    {
+    public:
+        // TYPEDEFS and MEMBER CONSTANTS
+        typedef double value_type;
+        typedef size_t size_type;
+        enum { CAPACITY = 30 };
+        enum { INLINE_CAPACITY = CAPACITY };
+        enum growth_kind { GROW_BY_HALF, GROW_BY_DOUBLING, GROW_BY_CHUNK, GROW_BY_TENTH };
+        typedef size_type (*growth_function)(size_type capacity);
+        typedef bool (*predicate)(const value_type& item);
+        // CONSTRUCTOR
+        sequence(size_type entry=CAPACITY );
+		   // COPY CONSTRUCTOR
+        sequence(const sequence& entry)   ;       
+        // MOVE CONSTRUCTOR
+        sequence(sequence&& source) noexcept;
+    // Library facilities used: cstdlib
+        // MODIFICATION MEMBER FUNCTIONS
+        void start( );
+        void advance( );
+        void insert(const value_type& entry);
+        void attach(const value_type& entry);
+        void remove_current( );
+        void insert_range(const value_type* first, const value_type* last);
+        void attach_range(const value_type* first, const value_type* last);
+        void remove_range(size_type count);
+        size_type remove_if(predicate test);
+		void resize(size_type );
+        void set_growth(growth_kind kind, size_type chunk = CAPACITY);
+        void set_growth(growth_function policy);
+		sequence& operator =(const sequence& source);
+		sequence& operator =(sequence&& source) noexcept;
+        void swap(sequence& other) noexcept;
+        // CONSTANT MEMBER FUNCTIONS
+        size_type size( ) const;
+        bool is_item( ) const;
+        value_type current( ) const;
+        size_type reallocations( ) const { return realloc_count; }
+        size_type bytes_copied( ) const { return copied_bytes; }
+		//Destructor
+		 ~sequence()  ;
+    private:
+        value_type *data;
+		size_type capacity;
+        size_type gap_start;   // Items before the cursor are data[0..gap_start-1]
+        size_type gap_end;     // Items from the cursor on are data[gap_end..capacity-1]
+        growth_kind growth;       // Built-in growth policy, if policy is NULL
+        size_type chunk;          // Items added by GROW_BY_CHUNK
+        growth_function policy;   // Growth policy supplied by the caller, or NULL
+        size_type realloc_count;  // Times the array has been resized
+        size_type copied_bytes;   // Bytes of items copied in resizing
+        value_type buffer[INLINE_CAPACITY];  // The items, while data == buffer
+        // HELPER MEMBER FUNCTIONS
+        void grow(size_type needed);
+        bool is_inline( ) const { return data == buffer; }
+    };
+
+    // NON-MEMBER FUNCTION
+    void swap(sequence& a, sequence& b) noexcept;
+}
+
+#endif
+
@@ -10,23 +10,29 @@
 // constants POINTS[1], POINTS[2]...
 
 #include <iostream>    // Provides cout.
-#include <string>      // Provides memcpy.
+#include <cstring>     // Provides memcpy.
 #include <cstdlib>     // Provides size_t.
+#include <utility>     // Provides move.
 #include "sequence2.h" // Provides the Sequence class with double items.
 using namespace std;
 using namespace CISP430_A2;
 
 // Descriptions and points for each of the tests:
-const size_t MANY_TESTS = 7;
+const size_t MANY_TESTS = 12;
 const int POINTS[MANY_TESTS+1] = {
-    200,  // Total points for all tests.
+    350,  // Total points for all tests.
      30,  // Test 1 points
      30,  // Test 2 points
      30,  // Test 3 points
      20,  // Test 4 points
      30,  // Test 5 points
      30,  // Test 6 points
-     30  // Test 7 points
+     30,  // Test 7 points
+     30,  // Test 8 points
+     30,  // Test 9 points
+     30,  // Test 10 points
+     30,  // Test 11 points
+     30   // Test 12 points
 };
 const char DESCRIPTION[MANY_TESTS+1][256] = {
     "tests for sequence class with a dynamic array",
@@ -36,7 +42,12 @@ const char DESCRIPTION[MANY_TESTS+1][256] = {
     "Testing the resize member function",
     "Testing the copy constructor",
     "Testing the assignment operator",
-    "Testing insert/attach when current DEFAULT_CAPACITY exceeded"
+    "Testing insert/attach when current DEFAULT_CAPACITY exceeded",
+    "Testing cursor moves and edits against an array model",
+    "Testing moves between the object's buffer and a dynamic array",
+    "Testing the growth policies and the resize counters",
+    "Testing the move constructor, move assignment and swap",
+    "Testing insert_range, attach_range, remove_range and remove_if"
 };
 
 
@@ -330,7 +341,8 @@ int test3( )
     double items3[3] = { 10, 20, 30 };
     
     size_t i;       // for-loop control variable
-    char *char_ptr; // Variable to loop at each character in a sequence's memory
+    char *char_ptr; // Variable to loop at each character of an item
+    sequence::value_type value;  // An item being checked
 
     // Build a sequence with three items 10, 20, 30, and remove the middle,
     // and last and then first.
@@ -398,19 +410,25 @@ int test3( )
     cout << "array outside of its legal indexes." << endl;
     for (i = 0; i < test.CAPACITY; i++)
         test.insert(0);
-    for (i = 0; i < test.CAPACITY; i++)
-        test.remove_current( );
 
-    // Make sure that the character 'x' didn't somehow get into the sequence,
+    // Make sure that the character 'x' didn't somehow get into the items,
     // as that would indicate that the sequence member functions are
     // copying data from before or after the sequence into the sequence.
-    char_ptr = (char *) &test;
-    for (i = 0; i < sizeof(sequence); i++)
-        if (char_ptr[i] == 'x')
-        {
-            cout << "Illegal array access detected." << endl;
-            return POINTS[3] / 4;
-        }
+    // (Only the items are checked: the sequence also holds pointers, and
+    // any of their bytes may happen to be an 'x'.)
+    for (test.start( ); test.is_item( ); test.advance( ))
+    {
+        value = test.current( );
+        char_ptr = (char *) &value;
+        for (i = 0; i < sizeof(value); i++)
+            if (char_ptr[i] == 'x')
+            {
+                cout << "Illegal array access detected." << endl;
+                return POINTS[3] / 4;
+            }
+    }
+    for (test.start( ), i = 0; i < test.CAPACITY; i++)
+        test.remove_current( );
 
     // Make sure that the prefix and suffix arrays still have four
     // x's each. Otherwise one of the sequence operations wrote outside of
@@ -485,6 +503,7 @@ int test4( )
     cout << test.CAPACITY*2 << " items." << endl;
     memcpy(bytes, (char *) &test, sizeof(sequence));
     test.resize(1);
+    memcpy(newbytes, (char *) &test, sizeof(sequence));
     mismatches = 0;
     for (i = 0; i < sizeof(sequence); i++)
         if (bytes[i] != newbytes[i])
@@ -723,6 +742,737 @@ int test7( )
     return POINTS[7];
 }  
 
+// **************************************************************************
+// bool matches_model(sequence& test, const double model[], size_t s, size_t cursor)
+//   Postcondition: A return value of true indicates that test has the s
+//   items model[0] ... model[s-1] and its current item is model[cursor] (or,
+//   if cursor == s, that it has no current item). To check the items, the
+//   cursor is walked from the start to the end of the sequence, and then
+//   back to where it was with start and advance.
+// **************************************************************************
+bool matches_model(sequence& test, const double model[], size_t s, size_t cursor)
+{
+    size_t i;
+
+    if (test.size( ) != s || test.is_item( ) != (cursor < s))
+        return false;
+    if (cursor < s && test.current( ) != model[cursor])
+        return false;
+    for (test.start( ), i = 0; i < s; test.advance( ), i++)
+        if (!test.is_item( ) || test.current( ) != model[i])
+            return false;
+    if (test.is_item( ))
+        return false;
+    test.start( );
+    for (i = 0; i < cursor; i++)
+        test.advance( );
+    return test.is_item( ) == (cursor < s);
+}
+
+
+// **************************************************************************
+// int test8( )
+//   Moves the cursor back and forth with start and advance (which moves
+//   items from one side of the gap to the other) and edits the sequence
+//   wherever the cursor lands, checking every step against an array.
+//   Returns POINTS[8] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test8( )
+{
+    const size_t MODEL_MAX = 400;
+    sequence test;
+    double model[MODEL_MAX];
+    size_t s = 0, cursor = 0;
+    size_t i, step;
+    unsigned long state = 2024;
+
+    cout << "I will attach 1 to 10, call start, advance five times and\n";
+    cout << "insert 100, so the sequence should be 1..5, 100, 6..10." << endl;
+    for (i = 1; i <= 10; i++)
+        test.attach(i);
+    test.start( );
+    for (i = 0; i < 5; i++)
+        test.advance( );
+    test.insert(100);
+    for (i = 0; i < 5; i++)
+        model[i] = i + 1;
+    model[5] = 100;
+    for (i = 6; i < 11; i++)
+        model[i] = i;
+    if (!matches_model(test, model, 11, 5))
+    {
+        cout << "    Failed." << endl;
+        return 0;
+    }
+    cout << "Now attach 200 after the 100 and remove the 6 that follows it." << endl;
+    test.attach(200);
+    test.advance( );
+    test.remove_current( );
+    model[6] = 200;
+    if (!matches_model(test, model, 11, 7))
+    {
+        cout << "    Failed." << endl;
+        return 0;
+    }
+    cout << "    Passed." << endl;
+
+    cout << "Now 20000 random moves and edits, checked against an array ...";
+    cout.flush( );
+    s = 11;
+    cursor = 7;
+    for (step = 0; step < 20000; step++)
+    {
+        state = (state * 1103515245 + 12345) & 0x7fffffff;
+        unsigned long choice = (state >> 8) % 100;
+        double entry = double(step);
+
+        if (choice < 5)
+        {   // start
+            test.start( );
+            cursor = 0;
+        }
+        else if (choice < 25)
+        {   // advance several times, possibly off the end
+            size_t moves = (state >> 16) % 16;
+            for (i = 0; i < moves && cursor < s; i++, cursor++)
+                test.advance( );
+        }
+        else if (choice < 50 && s < MODEL_MAX)
+        {   // insert before the cursor (at the front if there is none)
+            if (cursor == s)
+                cursor = 0;
+            for (i = s; i > cursor; i--)
+                model[i] = model[i-1];
+            model[cursor] = entry;
+            s++;
+            test.insert(entry);
+        }
+        else if (choice < 75 && s < MODEL_MAX)
+        {   // attach after the cursor (at the end if there is none)
+            cursor = (cursor == s) ? s : cursor + 1;
+            for (i = s; i > cursor; i--)
+                model[i] = model[i-1];
+            model[cursor] = entry;
+            s++;
+            test.attach(entry);
+        }
+        else if (cursor < s)
+        {   // remove the current item
+            for (i = cursor; i + 1 < s; i++)
+                model[i] = model[i+1];
+            s--;
+            test.remove_current( );
+        }
+
+        if (test.size( ) != s || test.is_item( ) != (cursor < s)
+            || (cursor < s && test.current( ) != model[cursor]))
+        {
+            cout << "\n    Step " << step << " left the wrong size or current item." << endl;
+            return 0;
+        }
+        if (step % 97 == 0 && !matches_model(test, model, s, cursor))
+        {
+            cout << "\n    Step " << step << " left the wrong items." << endl;
+            return 0;
+        }
+    }
+    if (!matches_model(test, model, s, cursor))
+    {
+        cout << "\n    The items are wrong at the end." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this eighth function have been passed." << endl;
+    return POINTS[8];
+}
+
+// **************************************************************************
+// int test9( )
+//   Moves the items from the sequence's own buffer to a dynamic array and
+//   back, and calls resize with fewer slots than there are items.
+//   Returns POINTS[9] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test9( )
+{
+    sequence test;
+    double items[3*sequence::CAPACITY];
+    size_t i, count;
+
+    for (i = 0; i < 3*sequence::CAPACITY; i++)
+        items[i] = i;
+
+    cout << "Filling the buffer of a new sequence should not resize it ...";
+    cout.flush( );
+    for (i = 0; i < sequence::INLINE_CAPACITY; i++)
+        test.attach(i);
+    if (test.reallocations( ) != 0 || !matches_model(test, items, i, i-1))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "One more item, inserted in the middle, moves them to a dynamic array ...";
+    cout.flush( );
+    test.start( );
+    for (i = 0; i < 12; i++)
+        test.advance( );
+    test.insert(100);
+    for (i = sequence::INLINE_CAPACITY; i > 12; i--)
+        items[i] = items[i-1];
+    items[12] = 100;
+    if (test.reallocations( ) != 1
+        || !matches_model(test, items, sequence::INLINE_CAPACITY + 1, 12))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Removing items and calling resize(1) moves them back to the buffer,\n";
+    cout << "keeping the current item ...";
+    cout.flush( );
+    test.start( );
+    for (i = 0; i < 20; i++)
+        test.advance( );
+    test.remove_range(6);  // Leaves 25 items
+    for (i = 20; i < 25; i++)
+        items[i] = items[i+6];
+    test.start( );
+    for (i = 0; i < 7; i++)
+        test.advance( );
+    count = test.reallocations( );
+    test.resize(1);
+    if (test.reallocations( ) != count + 1 || !matches_model(test, items, 25, 7))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "The buffer is then filled again without resizing ...";
+    cout.flush( );
+    for (i = 25; i < sequence::INLINE_CAPACITY; i++)
+        items[i] = -double(i);
+    while (test.is_item( ))
+        test.advance( );
+    for (i = 25; i < sequence::INLINE_CAPACITY; i++)
+        test.attach(items[i]);
+    if (test.reallocations( ) != count + 1
+        || !matches_model(test, items, sequence::INLINE_CAPACITY, sequence::INLINE_CAPACITY - 1))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "resize(1) with " << 2*sequence::CAPACITY << " items in a dynamic array";
+    cout << " keeps every item ...";
+    cout.flush( );
+    sequence big(3*sequence::CAPACITY);
+    for (i = 0; i < 2*sequence::CAPACITY; i++)
+    {
+        items[i] = i;
+        big.attach(i);
+    }
+    big.start( );
+    big.advance( );
+    big.resize(1);
+    if (big.reallocations( ) != 1 || !matches_model(big, items, 2*sequence::CAPACITY, 1))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    big.resize(1);  // Already as small as it can be
+    if (big.reallocations( ) != 1 || !matches_model(big, items, 2*sequence::CAPACITY, 1))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "A sequence made with a small capacity uses the buffer ...";
+    cout.flush( );
+    sequence small(5);
+    for (i = 0; i < sequence::INLINE_CAPACITY; i++)
+        small.insert(i);
+    if (small.reallocations( ) != 0 || small.size( ) != sequence::INLINE_CAPACITY)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this ninth function have been passed." << endl;
+    return POINTS[9];
+}
+
+// Growth rules for test10: the capacity a full array of capacity c grows to.
+size_t by_half(size_t c)     { return c + c/2; }
+size_t by_doubling(size_t c) { return 2*c; }
+size_t by_seven(size_t c)    { return c + 7; }
+size_t by_tenth(size_t c)    { return c + c/10; }
+size_t by_tripling(size_t c) { return 3*c; }
+size_t by_nothing(size_t c)  { return c/2; }   // Too small: grows by one
+
+// **************************************************************************
+// bool grows_like(sequence& test, size_t rule(size_t), size_t n)
+//   Postcondition: A return value of true indicates that, while n items were
+//   attached to the empty sequence test, it was resized exactly when its
+//   array was full, and that each time the new capacity was the larger of
+//   rule(capacity) and capacity + 1 (starting from CAPACITY).
+// **************************************************************************
+bool grows_like(sequence& test, size_t rule(size_t), size_t n)
+{
+    size_t capacity = sequence::CAPACITY;
+    size_t resizes = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        if (test.size( ) == capacity)
+        {
+            capacity = (rule(capacity) > capacity) ? rule(capacity) : capacity + 1;
+            resizes++;
+        }
+        test.attach(i);
+        if (test.reallocations( ) != resizes)
+            return false;
+    }
+    return test.size( ) == n;
+}
+
+
+// **************************************************************************
+// int test10( )
+//   Tests the growth policies and the counters reallocations( ) and
+//   bytes_copied( ).
+//   Returns POINTS[10] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test10( )
+{
+    const size_t MANY = 1 << 20;
+    sequence half, doubling, chunk, tenth, tripling, nothing;
+    size_t i;
+
+    cout << "Each growth policy must give the documented capacities ...";
+    cout.flush( );
+    doubling.set_growth(sequence::GROW_BY_DOUBLING);
+    chunk.set_growth(sequence::GROW_BY_CHUNK, 7);
+    tenth.set_growth(sequence::GROW_BY_TENTH);
+    tripling.set_growth(by_tripling);
+    nothing.set_growth(by_nothing);
+    if (!grows_like(half, by_half, 3000)
+        || !grows_like(doubling, by_doubling, 3000)
+        || !grows_like(chunk, by_seven, 3000)
+        || !grows_like(tenth, by_tenth, 3000)
+        || !grows_like(tripling, by_tripling, 3000)
+        || !grows_like(nothing, by_nothing, 100))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "A built-in policy set after a custom one replaces it ...";
+    cout.flush( );
+    sequence back;
+    back.set_growth(by_tripling);
+    back.set_growth(sequence::GROW_BY_DOUBLING);
+    if (!grows_like(back, by_doubling, 1000))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "A copy keeps the policy, with the counters back at zero ...";
+    cout.flush( );
+    sequence copy(tripling);
+    if (copy.reallocations( ) != 0 || copy.bytes_copied( ) != 0)
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    while (copy.size( ) > 0)
+    {
+        copy.start( );
+        copy.remove_current( );
+    }
+    copy.resize(1);
+    sequence fresh(copy);
+    if (!grows_like(fresh, by_tripling, 1000))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Filling a sequence with " << MANY << " items, at the end or at the\n";
+    cout << "front, must copy O(N) bytes ...";
+    cout.flush( );
+    sequence at_end, at_front;
+    for (i = 0; i < MANY; i++)
+    {
+        at_end.attach(i);
+        at_front.insert(i);
+    }
+    // Growing by half copies at most 3N items in all; the items after the
+    // gap may be moved once more.
+    if (at_end.bytes_copied( ) > 4 * MANY * sizeof(double)
+        || at_front.bytes_copied( ) > 7 * MANY * sizeof(double))
+    {
+        cout << " failed: " << at_end.bytes_copied( ) << " and ";
+        cout << at_front.bytes_copied( ) << " bytes." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    cout << "Shrinking a dynamic array keeps the items on both sides of the cursor ...";
+    cout.flush( );
+    sequence shrink;
+    double items[200];
+    for (i = 0; i < 200; i++)
+    {
+        items[i] = i;
+        shrink.attach(i);
+    }
+    shrink.start( );
+    for (i = 0; i < 150; i++)
+        shrink.remove_current( );   // Leaves 150..199, which follow the gap
+    shrink.insert(-1);
+    shrink.advance( );
+    items[149] = -1;
+    size_t resizes = shrink.reallocations( );
+    shrink.resize(60);
+    if (shrink.reallocations( ) != resizes + 1 || !matches_model(shrink, items + 149, 51, 1))
+    {
+        cout << " failed." << endl;
+        return 0;
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this tenth function have been passed." << endl;
+    return POINTS[10];
+}
+
+// **************************************************************************
+// void fill(sequence& test, double items[], size_t s, size_t cursor, double first)
+//   Postcondition: test has been emptied and given the s items first,
+//   first+1, ..., which are also stored in items[0] ... items[s-1]; its
+//   current item is items[cursor] (none if cursor >= s).
+// **************************************************************************
+void fill(sequence& test, double items[], size_t s, size_t cursor, double first)
+{
+    size_t i;
+
+    test.start( );
+    while (test.is_item( ))
+        test.remove_current( );
+    for (i = 0; i < s; i++)
+    {
+        items[i] = first + i;
+        test.attach(items[i]);
+    }
+    test.start( );
+    for (i = 0; i < cursor && i < s; i++)
+        test.advance( );
+}
+
+
+// **************************************************************************
+// bool empty_and_usable(sequence& test)
+//   Postcondition: A return value of true indicates that test is empty with
+//   no current item, and that items can still be inserted, attached and
+//   removed (past the size of the buffer, so that it must allocate).
+//   test is left empty.
+// **************************************************************************
+bool empty_and_usable(sequence& test)
+{
+    double items[2*sequence::CAPACITY];
+    size_t i;
+
+    if (test.size( ) != 0 || test.is_item( ))
+        return false;
+    for (i = 0; i < 2*sequence::CAPACITY; i++)
+        items[i] = i;
+    for (i = 2*sequence::CAPACITY; i > sequence::CAPACITY; i--)
+        test.insert(i - 1);
+    test.start( );
+    for (i = 0; i < sequence::CAPACITY; i++)
+        test.insert(sequence::CAPACITY - 1 - i);
+    if (!matches_model(test, items, 2*sequence::CAPACITY, 0))
+        return false;
+    test.remove_range(2*sequence::CAPACITY);
+    return test.size( ) == 0;
+}
+
+
+// **************************************************************************
+// int test11( )
+//   Tests the move constructor, the move assignment operator and swap, with
+//   sequences in their own buffers and in dynamic arrays.
+//   Returns POINTS[11] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test11( )
+{
+    const size_t SMALL = 10, LARGE = 100;
+    double a_items[LARGE], b_items[LARGE];
+    size_t sizes[2] = { SMALL, LARGE };
+    size_t i, j, resizes;
+
+    cout << "Move constructor, from a sequence in its buffer and from one in a\n";
+    cout << "dynamic array; the source must be left empty and usable ...";
+    cout.flush( );
+    for (i = 0; i < 2; i++)
+    {
+        sequence source;
+        fill(source, a_items, sizes[i], sizes[i] / 3, 1);
+        resizes = source.reallocations( );
+        sequence moved(std::move(source));
+        if (!matches_model(moved, a_items, sizes[i], sizes[i] / 3)
+            || moved.reallocations( ) != resizes || !empty_and_usable(source))
+        {
+            cout << " failed for " << sizes[i] << " items." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    cout << "Move assignment, for each mix of buffers and dynamic arrays ...";
+    cout.flush( );
+    for (i = 0; i < 2; i++)
+        for (j = 0; j < 2; j++)
+        {
+            sequence source, target;
+            fill(source, a_items, sizes[i], 2, 1);
+            fill(target, b_items, sizes[j], 3, 1000);
+            resizes = source.reallocations( );
+            target = std::move(source);
+            if (!matches_model(target, a_items, sizes[i], 2)
+                || target.reallocations( ) != resizes || !empty_and_usable(source))
+            {
+                cout << " failed for " << sizes[i] << " and " << sizes[j] << " items." << endl;
+                return 0;
+            }
+        }
+    cout << " passed." << endl;
+
+    cout << "swap, for each mix of buffers and dynamic arrays ...";
+    cout.flush( );
+    for (i = 0; i < 2; i++)
+        for (j = 0; j < 2; j++)
+        {
+            sequence a, b;
+            fill(a, a_items, sizes[i], sizes[i], 1);      // No current item
+            fill(b, b_items, sizes[j], 0, 1000);
+            b.set_growth(sequence::GROW_BY_CHUNK, 1);
+            size_t a_resizes = a.reallocations( ), b_resizes = b.reallocations( );
+            if (i == j)
+                a.swap(b);
+            else
+                swap(a, b);
+            if (!matches_model(a, b_items, sizes[j], 0) || !matches_model(b, a_items, sizes[i], sizes[i])
+                || a.reallocations( ) != b_resizes || b.reallocations( ) != a_resizes)
+            {
+                cout << " failed for " << sizes[i] << " and " << sizes[j] << " items." << endl;
+                return 0;
+            }
+            // The growth policy went with the items: once a is full, it grows
+            // one item at a time.
+            while (a.reallocations( ) == b_resizes)
+                a.attach(0);
+            for (resizes = 1; resizes <= 5; resizes++)
+                a.attach(0);
+            if (a.reallocations( ) != b_resizes + 6)
+            {
+                cout << " the growth policy was not swapped." << endl;
+                return 0;
+            }
+        }
+    cout << " passed." << endl;
+
+    cout << "Self-swap and self-move must leave a sequence as it was ...";
+    cout.flush( );
+    for (i = 0; i < 2; i++)
+    {
+        sequence test;
+        sequence& same = test;
+        fill(test, a_items, sizes[i], 4, 1);
+        test.swap(same);
+        swap(test, same);
+        if (!matches_model(test, a_items, sizes[i], 4))
+        {
+            cout << " swap failed for " << sizes[i] << " items." << endl;
+            return 0;
+        }
+        test = std::move(same);
+        if (!matches_model(test, a_items, sizes[i], 4))
+        {
+            cout << " move failed for " << sizes[i] << " items." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this eleventh function have been passed." << endl;
+    return POINTS[11];
+}
+
+// A test for remove_if in test12
+bool is_odd(const double& item) { return long(item) % 2 != 0; }
+bool is_any(const double&)      { return true; }
+
+// **************************************************************************
+// int test12( )
+//   Tests insert_range, attach_range, remove_range and remove_if against an
+//   array, with the cursor at the front, in the middle and off the end.
+//   Returns POINTS[12] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test12( )
+{
+    const size_t START = 20, ADDED = 100;
+    double range[ADDED];
+    double model[START + ADDED];
+    size_t spots[3] = { 0, START / 2, START };   // Front, middle, no cursor
+    size_t i, k, resizes;
+
+    for (i = 0; i < ADDED; i++)
+        range[i] = 1000 + i;
+
+    cout << "insert_range must put the items before the cursor (or at the front),\n";
+    cout << "make the first one current, and grow the array at most once ...";
+    cout.flush( );
+    for (k = 0; k < 3; k++)
+    {
+        sequence test;
+        fill(test, model, START, spots[k], 0);
+        size_t at = (spots[k] < START) ? spots[k] : 0;
+        for (i = START; i > at; i--)
+            model[i - 1 + ADDED] = model[i - 1];
+        for (i = 0; i < ADDED; i++)
+            model[at + i] = range[i];
+        resizes = test.reallocations( );
+        test.insert_range(range, range + ADDED);
+        if (test.reallocations( ) > resizes + 1 || !matches_model(test, model, START + ADDED, at))
+        {
+            cout << " failed with the cursor at " << spots[k] << "." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    cout << "attach_range must put the items after the cursor (or at the end),\n";
+    cout << "make the last one current, and grow the array at most once ...";
+    cout.flush( );
+    for (k = 0; k < 3; k++)
+    {
+        sequence test;
+        fill(test, model, START, spots[k], 0);
+        size_t at = (spots[k] < START) ? spots[k] + 1 : START;
+        for (i = START; i > at; i--)
+            model[i - 1 + ADDED] = model[i - 1];
+        for (i = 0; i < ADDED; i++)
+            model[at + i] = range[i];
+        resizes = test.reallocations( );
+        test.attach_range(range, range + ADDED);
+        if (test.reallocations( ) > resizes + 1
+            || !matches_model(test, model, START + ADDED, at + ADDED - 1))
+        {
+            cout << " failed with the cursor at " << spots[k] << "." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    cout << "A range that fits in the gap must not grow the array, and an\n";
+    cout << "empty range must change nothing ...";
+    cout.flush( );
+    {
+        sequence test(200);
+        fill(test, model, START, 5, 0);
+        test.insert_range(range, range);
+        test.attach_range(range, range);
+        test.remove_range(0);
+        if (test.reallocations( ) != 0 || !matches_model(test, model, START, 5))
+        {
+            cout << " failed." << endl;
+            return 0;
+        }
+        test.insert_range(range, range + 3);
+        test.attach_range(range + 3, range + ADDED);
+        if (test.reallocations( ) != 0 || test.size( ) != START + ADDED || test.current( ) != range[ADDED - 1])
+        {
+            cout << " failed." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    cout << "remove_range must remove items from the cursor on and make the\n";
+    cout << "next item current ...";
+    cout.flush( );
+    {
+        sequence test;
+        fill(test, model, START, 4, 0);
+        test.remove_range(6);
+        for (i = 4; i + 6 < START; i++)
+            model[i] = model[i + 6];
+        if (!matches_model(test, model, START - 6, 4))
+        {
+            cout << " failed." << endl;
+            return 0;
+        }
+        test.remove_range(START - 6 - 4);   // Everything after the cursor
+        if (!matches_model(test, model, 4, 4))
+        {
+            cout << " failed." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    cout << "remove_if must keep the current item if it stays, or else make the\n";
+    cout << "next kept item current ...";
+    cout.flush( );
+    for (k = 0; k <= START; k++)
+    {
+        sequence test;
+        fill(test, model, START, k, 0);
+        if (test.remove_if(is_odd) != START / 2)
+        {
+            cout << " failed: wrong count with the cursor at " << k << "." << endl;
+            return 0;
+        }
+        for (i = 0; i < START / 2; i++)
+            model[i] = 2 * i;
+        // The next kept item at or after k is the even number k or k + 1.
+        if (!matches_model(test, model, START / 2, (k + 1) / 2))
+        {
+            cout << " failed with the cursor at " << k << "." << endl;
+            return 0;
+        }
+    }
+    {
+        sequence test;
+        fill(test, model, START, 3, 0);
+        if (test.remove_if(is_any) != START || test.size( ) != 0 || test.is_item( ))
+        {
+            cout << " failed to remove every item." << endl;
+            return 0;
+        }
+    }
+    cout << " passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this twelfth function have been passed." << endl;
+    return POINTS[12];
+}
+
 int run_a_test(int number, const char message[], int test_function( ), int max)
 {
     int result;
@@ -762,6 +1512,11 @@ int main( )
     sum += run_a_test(5, DESCRIPTION[5], test5, POINTS[5]);
     sum += run_a_test(6, DESCRIPTION[6], test6, POINTS[6]);
     sum += run_a_test(7, DESCRIPTION[7], test7, POINTS[7]);
+    sum += run_a_test(8, DESCRIPTION[8], test8, POINTS[8]);
+    sum += run_a_test(9, DESCRIPTION[9], test9, POINTS[9]);
+    sum += run_a_test(10, DESCRIPTION[10], test10, POINTS[10]);
+    sum += run_a_test(11, DESCRIPTION[11], test11, POINTS[11]);
+    sum += run_a_test(12, DESCRIPTION[12], test12, POINTS[12]);
 
     cout << "If you submit this sequence now, you will have\n";
     cout << sum << " points out of the " << POINTS[0];